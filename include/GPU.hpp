@@ -1,13 +1,36 @@
 #ifndef GPU_H
 #define GPU_H
 
+#include "constants.hpp"
+#include "MMU.hpp"
+#include "state.hpp"
+#include "scanline.hpp"
+
 class GPU
 {
 	public:
-		GPU();
+		GPU(MMU*);
 		virtual ~GPU() {};
 
 		void step(int cycles);
+		void reset();
+		// cycles until the next mode change, -1 while the lcd is off
+		int cyclesUntilEvent();
+		// cycles until the next vblank starts, -1 while the lcd is off
+		int cyclesUntilVBlank();
+
+		// "GPU " chunk, LCD registers are saved with the MMU
+		void saveState(StateWriter&);
+		bool loadState(StateReader&);
+		// "FRAM" chunk with the picture drawn so far
+		void saveFrame(StateWriter&);
+		bool loadFrame(StateReader&);
+
+		// SCREEN_WIDTH * SCREEN_HEIGHT pixels, rows packed with no padding
+		const PIXEL* getFramebuffer() const { return framebuffer; }
+		// rows of the framebuffer whose pixels changed, the frontend clears them
+		// as it uploads them
+		bool* getDirtyRows() { return dirtyRows; }
 
 	private:
 		enum mode {
@@ -17,10 +40,35 @@ class GPU
 			VRAM = 3
 		};
 		enum mode gpuMode;
-		
-		bool isEnabled();
+
+		BYTE* vram;
+		BYTE* oam;
+		BYTE* io;
+		Interrupts* interrupts;
+		bool* dirtyTiles;
+		bool* tilesDirty;
+
+		// every tile in 8000-97FF expanded to one colour index per pixel,
+		// re-decoded when the MMU flags it as written
+		BYTE tiles[384][8][8];
+
 		int scanningCounter;
 		int currLine;
+		// line of the window to draw next, only advances when it's shown
+		int windowLine;
+
+		PIXEL framebuffer[SCREEN_WIDTH * SCREEN_HEIGHT];
+		bool dirtyRows[SCREEN_HEIGHT];
+
+		BYTE& reg(int address) { return io[address - 0xff00]; }
+		bool isEnabled();
+		void setMode(enum mode);
+		void setLine(int);
+
+		void renderScanline();
+		void renderTiles(BYTE* line, int tileMap, int mapY, int mapX, int from);
+		void renderSprites(BYTE* line);
+		void decodeTiles();
 };
 
-#endif
\ No newline at end of file
+#endif
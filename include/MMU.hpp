@@ -1,10 +1,15 @@
 #ifndef MMU_H
 #define MMU_H
 
-#include <fstream>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 #include "constants.hpp"
+#include "interrupts.hpp"
+#include "perf.hpp"
 #include "rom.hpp"
+#include "state.hpp"
 
 /* MEMORY MODEL:
 
@@ -46,23 +51,158 @@ class MMU
 		WORD readWord(WORD);
 		void writeByte(WORD, BYTE);
 		void writeWord(WORD, WORD);
-		void loadGame(std::ifstream&, BYTE);
-		BYTE getTimerFreq();
-		void dividerRegister(int);
+		void loadGame(std::shared_ptr<const ROMImage>, BYTE);
+
+		/*
+		 * Memory & bank controller registers in an "MMU " chunk. Loading
+		 * fails without changing anything if the state has a different
+		 * controller or cartridge RAM size.
+		 */
+		void saveState(StateWriter&);
+		bool loadState(StateReader&);
+
+		// ROM bank mapped at a cartridge address, for caching decoded code
+		int romBankAt(WORD address) { return romBanks[address >> 14]; }
+		// counts every change to which banks are mapped
+		unsigned int getROMSwitches() { return romSwitches; }
+#ifdef SGB_PERF_COUNTERS
+		// accesses through readByte & writeByte by region since power on
+		const uint64_t* getRegionReads() { return regionReads; }
+		const uint64_t* getRegionWrites() { return regionWrites; }
+#endif
+		// called before writes that move the timer or gpu's next event
+		void setTimingHandler(std::function<void()> handler) { timingHandler = handler; }
+		// DIV, TIMA, TMA & TAC go through these once set, else they're
+		// plain memory
+		void setTimerHandlers(std::function<BYTE(WORD)> read, std::function<void(WORD, BYTE)> write) {
+			timerRead = read;
+			timerWrite = write;
+		}
+
+		// raw memory for the gpu, which reads whole tile rows at a time
+		BYTE* getVRAM() { return vram; }
+		BYTE* getOAM() { return oam; }
+		BYTE* getIO() { return io; }
+		// IF & IE at FF0F & FFFF, with IME
+		Interrupts& getInterrupts() { return interrupts; }
+
+		// page tables for code that does its own fast path lookups
+		const BYTE* const* getReadPages() { return readPages; }
+		BYTE* const* getWritePages() { return writePages; }
+
+		// everything writable through the page tables: VRAM, cartridge
+		// RAM & internal RAM, one after the other
+		void copyRAM(std::vector<BYTE>&);
+		void restoreRAM(const std::vector<BYTE>&);
+
+		// tiles whose data changed since the gpu last decoded them
+		bool* getDirtyTiles() { return dirtyTiles; }
+		bool* getTilesDirty() { return &tilesDirty; }
 
 	private:
-		BYTE cartridge[0x8000];
+		enum mbcType {
+			MBC_NONE,
+			MBC1,
+			MBC3,
+			MBC5
+		};
+
+		// whole ROM image, shared with other instances & mapped in place
+		std::shared_ptr<const ROMImage> cartridge;
 		BYTE vram[0x2000];
-		BYTE xram[0x2000];
+		// one flag per 16 byte tile in 8000-97FF, tilesDirty if any are set
+		bool dirtyTiles[384];
+		bool tilesDirty;
+		// external cartridge RAM, all banks, sized from the header
+		std::vector<BYTE> xram;
 		BYTE wram[0x2000];
 		BYTE oam[0x100];
 		BYTE io[0x80];
 		BYTE ram[0x80];
+		Interrupts interrupts;
+
+		// one entry per 256 byte page, indexed by the high byte of the
+		// address. NULL sends the access through readSlow/writeSlow
+		const BYTE* readPages[0x100];
+		BYTE* writePages[0x100];
 
-		// BYTE cartridgeBanks[0x8000];
-		// BYTE ramBanks[0x8000];
-		BYTE currROMBank;
+		enum mbcType mbc;
+		WORD currROMBank;
 		BYTE currRAMBank;
+		bool ramEnabled;
+		// MBC1 upper bank bits & banking mode
+		BYTE bankHigh;
+		bool ramBankingMode;
+		// MBC3 clock registers, selected through the RAM bank register
+		BYTE rtc[5];
+		// banks mapped at 0000-3FFF & 4000-7FFF
+		int romBanks[2];
+		unsigned int romSwitches;
+
+#ifdef SGB_PERF_COUNTERS
+		uint64_t regionReads[REGION_COUNT];
+		uint64_t regionWrites[REGION_COUNT];
+#endif
+		std::function<void()> timingHandler;
+		std::function<BYTE(WORD)> timerRead;
+		std::function<void(WORD, BYTE)> timerWrite;
+
+		void mapRead(int first, int count, const BYTE* base);
+		void mapWrite(int first, int count, BYTE* base);
+		void mapROMBanks();
+		void mapSwitchableBank();
+		void mapRAMBank();
+		void writeBankControl(WORD, BYTE);
+		void markTilesDirty();
+		size_t ramSize(BYTE);
+		BYTE readSlow(WORD);
+		void writeSlow(WORD, BYTE);
 };
 
+/*
+ * Read an 8-bit section from memory
+*/
+inline BYTE MMU::readByte(WORD address)
+{
+#ifdef SGB_PERF_COUNTERS
+	regionReads[regionOf(address)]++;
+#endif
+	const BYTE* page = readPages[address >> 8];
+	if (page != NULL)
+	{
+		return page[address & 0xff];
+	}
+
+	return readSlow(address);
+}
+
+/*
+ * Read a 16-bit word from memory
+*/
+inline WORD MMU::readWord(WORD address)
+{
+	return readByte(address) | (readByte(address + 1) << 8);
+}
+
+inline void MMU::writeByte(WORD address, BYTE data)
+{
+#ifdef SGB_PERF_COUNTERS
+	regionWrites[regionOf(address)]++;
+#endif
+	BYTE* page = writePages[address >> 8];
+	if (page != NULL)
+	{
+		page[address & 0xff] = data;
+		return;
+	}
+
+	writeSlow(address, data);
+}
+
+inline void MMU::writeWord(WORD address, WORD data)
+{
+	writeByte(address, data & 0xff);
+	writeByte(address + 1, (data >> 8) & 0xff);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef BLOCK_H
+#define BLOCK_H
+
+#include <cstdint>
+#include "constants.hpp"
+#include "registers.hpp"
+
+// longest run of straight line code decoded into one block
+static const int MAX_BLOCK = 32;
+
+// an instruction with its operand already read from ROM
+struct decodedInstruction
+{
+	WORD operand;
+	BYTE opcode;
+	BYTE length;
+};
+
+#ifdef SGB_JIT
+/*
+ * Native code for the start of a block, see jit.hpp. Returns the cycles
+ * run in bits 0-15, the instructions run in bits 16-23 & extra cycles for
+ * a taken branch in bits 24-31, with PC left at the next instruction.
+ */
+typedef uint32_t (*nativeBlock)(Registers*, lazyFlags*, const BYTE* const* readPages, BYTE* const* writePages);
+#endif
+
+// straight line ROM code up to & including the first jump, call,
+// return or other control flow instruction
+struct block
+{
+	int count;
+	decodedInstruction instructions[MAX_BLOCK];
+#ifdef SGB_JIT
+	// times run before being compiled, -1 once it can't be
+	int runs;
+	nativeBlock native;
+	// instructions the native code covers & their cycles bar the last
+	int nativeCount;
+	int nativeCycles;
+	// where the native code was compiled, it bakes in absolute PCs so
+	// can't run when the same bank shows up in the other ROM window
+	WORD nativePC;
+#endif
+};
+
+#endif
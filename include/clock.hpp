@@ -1,20 +1,29 @@
 #ifndef CLOCK_H
 #define CLOCK_H
 
+#include <cstdint>
+#include "state.hpp"
+
+/*
+ * Clock cycles (4 to a machine cycle) since power on. The cpu's is the
+ * emulator's timebase: events are scheduled, the timer read & states saved
+ * against it. 64 bits don't wrap in any run.
+ */
 class Clock
 {
 	public:
-		Clock();
+		Clock() : cycles(0) {};
 		virtual ~Clock() {};
 
-		// cycles in clock cycles
-		void updateClocks(int cycles);
-		void resetClocks();
+		void advance(int elapsed) { cycles += elapsed; }
+		uint64_t now() const { return cycles; }
+		void reset() { cycles = 0; }
+
+		void saveState(StateWriter&);
+		void loadState(StateReader&);
 
 	private:
-		// 1 machine cycle == 4 clock cycles
-		unsigned int machineCycles;
-		unsigned int clockCycles;
+		uint64_t cycles;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -11,11 +11,16 @@ typedef char SIGNED_BYTE;
 typedef unsigned short WORD;
 typedef short SIGNED_WORD;
 
+// b1 is the high register of the pair (A, B, D, H) & b2 the low one
 union Word {
 	WORD w;
 
 	struct Byte {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
 		BYTE b1, b2;
+#else
+		BYTE b2, b1;
+#endif
 	}
 	b;
 };
@@ -39,8 +44,26 @@ inline HexCharStruct hex(BYTE _c)
 const int REFRESHRATE = 60; // gameboy refreshes screen 60 times per sec
 const int CLOCKSPEED = 4194304; // gameboy can execute 4194304 clock cycles each second
 const int MAXCYCLES = 69905; // max cpu cycles per frame
+const int DIV = 0xFF04; // divider, counts up every 256 cycles
 const int TIMA = 0xFF05;
 const int TMA = 0xFF06;
 const int TMC = 0xFF07;
+const int IF = 0xFF0F; // interrupt flags
+const int IE = 0xFFFF; // interrupt enable
+const int LCDC = 0xFF40; // lcd control
+const int STAT = 0xFF41; // lcd status
+const int SCY = 0xFF42;
+const int SCX = 0xFF43;
+const int LY = 0xFF44; // current scanline
+const int LYC = 0xFF45;
+const int DMA = 0xFF46;
+const int BGP = 0xFF47;
+const int OBP0 = 0xFF48;
+const int OBP1 = 0xFF49;
+const int WY = 0xFF4A;
+const int WX = 0xFF4B;
+
+const int SCREEN_WIDTH = 160;
+const int SCREEN_HEIGHT = 144;
 
 #endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef EMITTER_H
+#define EMITTER_H
+
+#include <cstdint>
+#include <vector>
+#include "constants.hpp"
+
+/*
+ * Just enough of an x86-64 assembler for the JIT. Register operands are
+ * 32 bit unless the name says otherwise, byte operands are the low byte
+ * of the register (a REX prefix is added so 4-7 mean spl-dil, never ah-bh).
+ */
+
+enum hostReg {
+	RAX, RCX, RDX, RBX, RSP, RBP, RSI, RDI,
+	R8, R9, R10, R11, R12, R13, R14, R15
+};
+
+// the /digit of the 0x01-0x3f & 0x81 group
+enum aluOp {
+	ALU_ADD = 0,
+	ALU_OR = 1,
+	ALU_ADC = 2,
+	ALU_SBB = 3,
+	ALU_AND = 4,
+	ALU_SUB = 5,
+	ALU_XOR = 6,
+	ALU_CMP = 7
+};
+
+// the /digit of 0xc1
+enum shiftOp {
+	SHIFT_SHL = 4,
+	SHIFT_SHR = 5
+};
+
+// low nibble of the jcc opcode
+enum condition {
+	COND_Z = 0x4,
+	COND_NZ = 0x5
+};
+
+class Emitter
+{
+	public:
+		const std::vector<BYTE>& code() const { return buffer; }
+		int size() const { return buffer.size(); }
+
+		void mov(hostReg dst, hostReg src);
+		void mov64(hostReg dst, hostReg src);
+		void movImm(hostReg dst, uint32_t imm);
+		void movzx8(hostReg dst, hostReg src);
+		void alu(aluOp op, hostReg dst, hostReg src);
+		void aluImm(aluOp op, hostReg dst, int32_t imm);
+		void shiftImm(shiftOp op, hostReg dst, BYTE count);
+		void test64(hostReg a, hostReg b);
+
+		// dst = 64 bit [base + index * 8]
+		void load64Indexed(hostReg dst, hostReg base, hostReg index);
+		// dst = zero extended byte [base + index], [base + index] = src byte
+		void load8Indexed(hostReg dst, hostReg base, hostReg index);
+		void store8Indexed(hostReg base, hostReg index, hostReg src);
+
+		// zero extended loads & stores at [base + disp]
+		void load8(hostReg dst, hostReg base, int disp);
+		void load16(hostReg dst, hostReg base, int disp);
+		void load32(hostReg dst, hostReg base, int disp);
+		void store8(hostReg base, int disp, hostReg src);
+		void store16(hostReg base, int disp, hostReg src);
+		void store32(hostReg base, int disp, hostReg src);
+		void store8Imm(hostReg base, int disp, BYTE imm);
+		void store16Imm(hostReg base, int disp, WORD imm);
+		void store32Imm(hostReg base, int disp, uint32_t imm);
+		void cmp8Imm(hostReg base, int disp, BYTE imm);
+		void test32Imm(hostReg base, int disp, uint32_t imm);
+
+		/*
+		 * Jumps return the position of their 32 bit displacement, which
+		 * bind points at the current end of the code.
+		 */
+		int jcc(condition);
+		int jmp();
+		void bind(int jump);
+		void bindTo(int jump, int target);
+
+		void push(hostReg);
+		void pop(hostReg);
+		void ret();
+
+	private:
+		std::vector<BYTE> buffer;
+
+		void byte(BYTE value) { buffer.push_back(value); }
+		void dword(uint32_t value);
+		void rex(bool wide, int reg, int index, int base, bool byteRegs);
+		void registerOperand(int reg, int rm);
+		void memoryOperand(int reg, int base, int index, int scale, int disp);
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef INTERRUPTS_H
+#define INTERRUPTS_H
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include "constants.hpp"
+
+// IF & IE bits, highest priority first
+enum interruptBit {
+	INT_VBLANK = 0x01,
+	INT_STAT = 0x02,
+	INT_TIMER = 0x04,
+	INT_SERIAL = 0x08,
+	INT_JOYPAD = 0x10
+};
+
+/*
+ * IF, IE & IME, mapped into memory by the MMU. Whether the cpu has an
+ * interrupt to take is worked out whenever one of them changes, so the cpu
+ * only has to test a bool between blocks.
+ */
+class Interrupts
+{
+	public:
+		Interrupts() { reset(); }
+		virtual ~Interrupts() {};
+
+		void reset() { flags = 0; enabled = 0; master = false; update(); }
+
+		void request(BYTE bits) { flags |= bits; update(); }
+
+		// unused IF bits read as 1
+		BYTE readIF() const { return flags | 0xe0; }
+		void writeIF(BYTE value) { flags = value & 0x1f; update(); }
+		BYTE readIE() const { return enabled; }
+		void writeIE(BYTE value) { enabled = value; update(); }
+		bool getIME() const { return master; }
+		void setIME(bool value) { master = value; update(); }
+
+		// an enabled interrupt is flagged, which wakes HALT even with IME off
+		bool requested() const { return flags & enabled & 0x1f; }
+		// ... & IME is on, so the cpu should take it
+		bool pending() const { return dispatch; }
+
+		/*
+		 * Take the highest priority pending interrupt: clear its IF bit &
+		 * IME, returns the address of its handler
+		 */
+		WORD acknowledge()
+		{
+			unsigned int bit = lowestBit(flags & enabled & 0x1f);
+			flags &= ~(1 << bit);
+			master = false;
+			update();
+			return 0x40 + bit * 8;
+		}
+
+	private:
+		BYTE flags;
+		BYTE enabled;
+		bool master;
+		bool dispatch;
+
+		void update() { dispatch = master && requested(); }
+
+		static unsigned int lowestBit(unsigned int value)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, value);
+			return index;
+#else
+			return __builtin_ctz(value);
+#endif
+		}
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef JIT_H
+#define JIT_H
+
+#ifdef SGB_JIT
+
+#if !defined(__x86_64__) || defined(_WIN32)
+#error "SGB_JIT needs an x86-64 host with the System V calling convention"
+#endif
+#ifndef SGB_LAZY_FLAGS
+#error "SGB_JIT writes the lazy flags & needs SGB_LAZY_FLAGS"
+#endif
+
+#include <cstddef>
+#include "block.hpp"
+
+/*
+ * Translates the start of decoded ROM blocks into x86-64. A, BC, DE, HL &
+ * SP are held in host registers for the whole block & only written back on
+ * the way out. Loads & stores go through the MMU's page tables inline; a
+ * page without plain memory behind it (I/O, bank control, disabled RAM)
+ * leaves the native code at that instruction for the interpreter to run.
+ *
+ * Only ROM is compiled, so code can't change under the translation.
+ */
+class JIT
+{
+	public:
+		JIT();
+		virtual ~JIT();
+
+		/*
+		 * Compile as much of decoded, which starts at pc, as is supported.
+		 * cycles are the base cycles of each instruction. Fills in the
+		 * block's native fields, false if nothing could be compiled or the
+		 * code space is full.
+		 */
+		bool compile(block& decoded, WORD pc, const BYTE* cycles);
+
+		// instructions the translator handles
+		static bool supports(const decodedInstruction&);
+
+		// bytes of code space used
+		size_t codeSize() const { return used; }
+
+	private:
+		BYTE* arena;
+		size_t used;
+
+		BYTE* place(const BYTE* code, size_t length);
+};
+
+#endif
+
+#endif
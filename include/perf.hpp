@@ -0,0 +1,102 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <cstdint>
+#include "constants.hpp"
+
+#ifdef SGB_PERF_COUNTERS
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+// parts of the memory map MMU accesses are counted by
+enum memoryRegion {
+	REGION_ROM0,
+	REGION_ROMX,
+	REGION_VRAM,
+	REGION_XRAM,
+	REGION_WRAM,
+	REGION_ECHO,
+	REGION_OAM,
+	REGION_IO,
+	REGION_HRAM,
+	REGION_COUNT
+};
+
+extern const char* const memoryRegionNames[REGION_COUNT];
+
+inline enum memoryRegion regionOf(WORD address)
+{
+	static const enum memoryRegion regions[16] = {
+		REGION_ROM0, REGION_ROM0, REGION_ROM0, REGION_ROM0,
+		REGION_ROMX, REGION_ROMX, REGION_ROMX, REGION_ROMX,
+		REGION_VRAM, REGION_VRAM, REGION_XRAM, REGION_XRAM,
+		REGION_WRAM, REGION_WRAM, REGION_ECHO, REGION_ECHO
+	};
+
+	if (address >= 0xfe00)
+	{
+		return address < 0xff00 ? REGION_OAM : address < 0xff80 ? REGION_IO : REGION_HRAM;
+	}
+	return regions[address >> 12];
+}
+
+/*
+ * Host cost of the last frame, filled in by sGBEmulator::update when built
+ * with SGB_PERF_COUNTERS, all zero otherwise. Times are in nanoseconds.
+ * Reads & writes are the ones made through the MMU, which leaves out code
+ * fetched from decoded blocks & the JIT's inline accesses.
+ */
+struct perfCounters
+{
+	uint64_t frame;
+
+	uint64_t updateTime;
+	uint64_t cpuTime;
+	uint64_t timerTime;
+	uint64_t gpuTime;
+	uint64_t interruptTime;
+
+	uint64_t instructions;
+	uint64_t romBankSwitches;
+	uint64_t reads[REGION_COUNT];
+	uint64_t writes[REGION_COUNT];
+};
+
+/*
+ * Raw host timestamps, the TSC where there is one. Ticks are turned into
+ * nanoseconds once a frame against the steady clock.
+ */
+inline uint64_t perfTicks()
+{
+#ifdef SGB_PERF_COUNTERS
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+#else
+	return 0;
+#endif
+}
+
+// adds the ticks spent in its scope to total, nothing without SGB_PERF_COUNTERS
+class PerfTimer
+{
+	public:
+#ifdef SGB_PERF_COUNTERS
+		PerfTimer(uint64_t& total) : total(total), start(perfTicks()) {};
+		~PerfTimer() { total += perfTicks() - start; }
+
+	private:
+		uint64_t& total;
+		uint64_t start;
+#else
+		PerfTimer(uint64_t&) {};
+#endif
+};
+
+#endif
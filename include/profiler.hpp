@@ -0,0 +1,90 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#ifdef SGB_PROFILE
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "constants.hpp"
+
+/*
+ * Counts what the emulated program spends its time on: executions of each
+ * (ROM bank, PC), instructions & cycles of each opcode (CB xx at 0x100 +
+ * xx) & cycles under each call stack seen through CALL, RST & RET.
+ *
+ * Every counter is allocated up front, counting an instruction only adds to
+ * a few array entries. Built with SGB_PROFILE only.
+ */
+class Profiler
+{
+	public:
+		Profiler();
+		virtual ~Profiler() {};
+
+		// size the counters for a ROM of banks 16kB banks & zero them
+		void reset(int banks);
+
+		void instruction(int bank, WORD pc, int opcode, unsigned int cycles);
+		// a call to target just pushed its return address, leaving sp
+		void call(int bank, WORD target, WORD sp);
+		// a return just popped its address, leaving sp
+		void ret(WORD sp);
+
+		/*
+		 * Hot spot report: the top (bank, PC)s by executions then every
+		 * opcode run by cycles. names has 512 entries, one per opcode.
+		 */
+		void writeReport(std::ostream&, const std::vector<const char*>& names, size_t top);
+		// one line per call stack with its cycles, as flamegraph.pl reads
+		void writeCollapsed(std::ostream&);
+
+	private:
+		// call tree, children are a linked list off the first child
+		struct node {
+			// bank << 16 | address of the function, the root is -1
+			int64_t function;
+			int parent;
+			int child;
+			int sibling;
+			uint64_t cycles;
+		};
+
+		struct frame {
+			int node;
+			WORD sp;
+		};
+
+		static const int MAX_NODES = 1 << 16;
+		static const int MAX_DEPTH = 256;
+
+		int romBanks;
+		// per bank & PC in ROM, then 8000-FFFF
+		std::vector<uint64_t> counts;
+		uint64_t opcodeCounts[0x200];
+		uint64_t opcodeCycles[0x200];
+		uint64_t totalInstructions;
+		uint64_t totalCycles;
+
+		std::vector<node> nodes;
+		frame stack[MAX_DEPTH];
+		int depth;
+		int current;
+
+		void writeStack(std::ostream&, int node);
+};
+
+inline void Profiler::instruction(int bank, WORD pc, int opcode, unsigned int cycles)
+{
+	size_t slot = pc < 0x8000 ? bank * 0x4000 + (pc & 0x3fff) : romBanks * 0x4000 + (pc - 0x8000);
+	counts[slot]++;
+	opcodeCounts[opcode]++;
+	opcodeCycles[opcode] += cycles;
+	nodes[current].cycles += cycles;
+	totalInstructions++;
+	totalCycles += cycles;
+}
+
+#endif
+
+#endif
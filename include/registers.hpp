@@ -8,7 +8,8 @@
 #define flag_n (1 << 6)
 #define flag_z (1 << 7)
 
-struct Registers
+// whole register file fits in & starts a cache line
+struct alignas(64) Registers
 {
 	Word af; // union of a and f
 	Word bc; // union of b and c
@@ -19,16 +20,40 @@ struct Registers
 	WORD pc; // program counter (PC)
 };
 
-extern bool flagCarry(Registers& r);
+/*
+ * Raw inputs of the last flag update, F is only built when read. Plain
+ * layout as compiled code writes the fields directly.
+ */
+struct lazyFlags
+{
+	BYTE zeroResult; // Z when 0
+	bool negative;
+	unsigned int halfBits; // H is bit 4
+	unsigned int carryBits; // C is bit 8
+};
+
+inline bool flagCarry(const Registers& r) {
+	return r.af.b.b2 & flag_c;
+}
 
-extern bool flagHalf(Registers& r);
+inline bool flagHalf(const Registers& r) {
+	return r.af.b.b2 & flag_h;
+}
 
-extern bool flagNegative(Registers& r);
+inline bool flagNegative(const Registers& r) {
+	return r.af.b.b2 & flag_n;
+}
 
-extern bool flagZero(Registers& r);
+inline bool flagZero(const Registers& r) {
+	return r.af.b.b2 & flag_z;
+}
 
-extern void flagSet(Registers& r, BYTE f);
+inline void flagSet(Registers& r, BYTE f) {
+	r.af.b.b2 |= f;
+}
 
-extern void flagClear(Registers& r, BYTE f);
+inline void flagClear(Registers& r, BYTE f) {
+	r.af.b.b2 &= ~f;
+}
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,60 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+#include "constants.hpp"
+
+/*
+ * Recent save states, oldest dropped first. Every keyframeInterval-th state
+ * is a keyframe that stands on its own, the ones in between only hold the
+ * XOR with the state before. Frame to frame most of memory doesn't change,
+ * so that is nearly all zeros & both kinds are stored as runs of zeros
+ * between literal bytes.
+ */
+class RewindBuffer
+{
+	public:
+		RewindBuffer(size_t frames = 0, size_t keyframeInterval = 60);
+		virtual ~RewindBuffer() {};
+
+		// states held at most, 0 turns recording off & frees everything
+		void setCapacity(size_t frames);
+		size_t capacity() const { return maxFrames; }
+
+		void push(const std::vector<BYTE>& state);
+		// forget the newest state, false when there was none
+		bool pop();
+		// state back states before the newest one (0 is the newest)
+		bool get(size_t back, std::vector<BYTE>& out) const;
+
+		size_t size() const { return entries.size(); }
+		// bytes of encoded states held
+		size_t memoryUsed() const { return encodedBytes; }
+		void clear();
+
+	private:
+		struct entry {
+			bool keyframe;
+			// decoded length
+			size_t length;
+			std::vector<BYTE> data;
+		};
+
+		std::deque<entry> entries;
+		// last state pushed as is, the base for the next delta
+		std::vector<BYTE> newest;
+		// storage of dropped entries, reused so a full buffer doesn't allocate
+		std::vector<BYTE> spare;
+		size_t maxFrames;
+		size_t keyframeInterval;
+		size_t sinceKeyframe;
+		size_t encodedBytes;
+
+		static void encode(const BYTE* state, const BYTE* base, size_t length, std::vector<BYTE>& out);
+		static void apply(const std::vector<BYTE>& encoded, BYTE* state);
+		void dropOldest();
+};
+
+#endif
@@ -1,8 +1,12 @@
 #ifndef ROM_H
 #define ROM_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
+#include "constants.hpp"
 
 // ROM types listed by type
 // this is read from memory location 0x0147
@@ -42,4 +46,35 @@ const int ROM_TYPE_ADDRESS = 0x0147;
 const int ROM_SIZE_ADDRESS = 0x0148;
 const int RAM_SIZE_ADDRESS = 0x0149;
 
+/*
+ * Read only image of a ROM file. The file is mmapped once and shared by
+ * every emulator instance in the process that opens it, through whichever
+ * path or symlink. The image is unmapped when the last handle goes away.
+ */
+class ROMImage
+{
+	public:
+		static std::shared_ptr<const ROMImage> open(const std::string&);
+		virtual ~ROMImage();
+
+		const BYTE* data() const { return bytes; }
+		size_t size() const { return length; }
+		// identifies the image in save states, which don't include it
+		uint64_t hash() const { return contentHash; }
+
+	private:
+		ROMImage();
+		ROMImage(const ROMImage&);
+		ROMImage& operator=(const ROMImage&);
+
+		bool load(const std::string&);
+
+		const BYTE* bytes;
+		size_t length;
+		uint64_t contentHash;
+		size_t mappedLength;
+		// used instead of a mapping when the file can't be mapped as is
+		std::vector<BYTE> copy;
+};
+
 #endif
\ No newline at end of file
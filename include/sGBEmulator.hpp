@@ -1,12 +1,18 @@
 #ifndef SGBEMULATOR_H
 #define SGBEMULATOR_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <fstream>
+#include <vector>
+#include "scheduler.hpp"
 #include "timer.hpp"
 #include "CPU.hpp"
 #include "GPU.hpp"
+#include "perf.hpp"
+#include "rewind.hpp"
+#include "rom.hpp"
+#include "state.hpp"
 
 class sGBEmulator
 {
@@ -16,19 +22,101 @@ class sGBEmulator
 
 		bool update();
 
+		// see CPU::setJITMode, false when the JIT isn't built in
+		bool setJITMode(CPU::jitMode mode) { return cpu->setJITMode(mode); }
+		unsigned int getJITMismatches() { return cpu->getJITMismatches(); }
+
+		/*
+		 * Bring the timer & gpu up to date & check interrupts after every
+		 * instruction instead of at scheduled events. Much slower, it's the
+		 * reference the scheduler is tested against.
+		 */
+		void setStepping(bool on) { stepping = on; }
+
+		/*
+		 * Snapshot everything but the ROM, between calls to update. out is
+		 * cleared first & keeps its capacity, so saving every frame into
+		 * the same buffer doesn't allocate.
+		 */
+		void saveState(std::vector<BYTE>& out);
+		// false, leaving the emulator as it was, unless in is a state of
+		// the loaded ROM
+		bool loadState(const std::vector<BYTE>& in);
+		bool saveState(const std::string& path);
+		bool loadState(const std::string& path);
+
+		/*
+		 * Keep the state at the end of each of the last frames frames for
+		 * rewinding, 0 (the default) stops recording & frees the history.
+		 */
+		void setRewindLength(size_t frames) { rewindBuffer.setCapacity(frames); }
+		// back one frame, redrawing it, false once the history runs out
+		bool rewind();
+		size_t rewindFrames() const { return rewindBuffer.size(); }
+		size_t rewindMemory() const { return rewindBuffer.memoryUsed(); }
+
+#ifdef SGB_PROFILE
+		/*
+		 * Write the profile so far to path.txt, a hot spot report, & to
+		 * path.folded, call stacks for flamegraph.pl
+		 */
+		bool writeProfile(const std::string& path);
+#endif
+
+		// host cost of the last update, see perf.hpp
+		const perfCounters& getPerfCounters() const { return perf; }
+
+		// latest frame, written a scanline at a time by the gpu
+		const PIXEL* getFramebuffer() const { return gpu->getFramebuffer(); }
+		bool* getDirtyRows() { return gpu->getDirtyRows(); }
+
 	private:
 		std::string romPath;
-		std::ifstream romFile;
+		std::shared_ptr<const ROMImage> rom;
 		std::unique_ptr<CPU> cpu;
 		std::unique_ptr<GPU> gpu;
 		std::unique_ptr<Timer> timer;
+		Scheduler scheduler;
+		// state before the last loadState, kept to reuse its memory
+		std::vector<BYTE> previousState;
+		RewindBuffer rewindBuffer;
+		std::vector<BYTE> rewindState;
+
+		perfCounters perf;
+		// running totals as the frame started & ticks spent in each part
+		// of update since
+		perfCounters perfStart;
+		uint64_t perfStartTicks;
+		struct {
+			uint64_t cpu;
+			uint64_t timer;
+			uint64_t gpu;
+			uint64_t interrupt;
+		} perfTicksSpent;
+
+		// the cpu's clock, how far the timer & gpu have been brought up
+		// to & when the cpu next has to stop for them
+		const Clock* clock;
+		uint64_t syncedCycles;
+		uint64_t deadline;
+		bool stepping;
 
-		int cpuStep();
-		void timerStep(int);
+		int cpuStep(int budget);
+		void timerStep(uint64_t now);
 		void gpuStep(int);
 		void interruptStep();
+		void sync(uint64_t now);
+		void reschedule();
+		void rescheduleHalted();
+		void scheduleTimer();
+		void timingWrite();
 
 		bool initialize();
+		bool runFrame();
+		void startPerfFrame();
+		void endPerfFrame();
+		void writeState(std::vector<BYTE>&, bool withFrame);
+		bool applyState(const std::vector<BYTE>&);
 
 };
 
@@ -0,0 +1,31 @@
+#ifndef SCANLINE_H
+#define SCANLINE_H
+
+#include <cstdint>
+#include "constants.hpp"
+
+// one ARGB8888 pixel of the framebuffer
+typedef uint32_t PIXEL;
+
+/*
+ * Pixel kernels for the gpu. Each has a plain C++ version and SSE2/AVX2
+ * versions picked at runtime where the host supports them.
+ */
+
+// Expand an 8x8 tile (16 bytes of 2bpp rows) into 64 colour indices
+void decodeTile(const BYTE* data, BYTE* out);
+void decodeTileScalar(const BYTE* data, BYTE* out);
+
+/*
+ * Combine a line of background colour indices (0-3) with a line of sprite
+ * pixels (0 for none, else index in bits 0-1, palette in bit 2 & bit 3 set
+ * when behind background colours 1-3) and map the result through colours:
+ * entries 0-3 for the background, 4-7 & 8-11 for the two sprite palettes.
+ */
+void composeScanline(const BYTE* background, const BYTE* sprites, const PIXEL* colours, PIXEL* out, int width);
+void composeScanlineScalar(const BYTE* background, const BYTE* sprites, const PIXEL* colours, PIXEL* out, int width);
+
+// name of the kernel composeScanline dispatches to
+const char* scanlineKernel();
+
+#endif
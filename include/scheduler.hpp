@@ -0,0 +1,50 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <cstdint>
+
+/*
+ * Min-heap of upcoming events keyed by the cycle they're due on. Each kind
+ * of event is pending at most once, scheduling it again moves it.
+ */
+class Scheduler
+{
+	public:
+		enum event {
+			FRAME_END,
+			TIMER,
+			GPU_MODE,
+			EVENT_COUNT
+		};
+
+		static const uint64_t NEVER = UINT64_MAX;
+
+		Scheduler();
+		virtual ~Scheduler() {};
+
+		void schedule(enum event, uint64_t when);
+		void cancel(enum event);
+		void clear();
+
+		// cycle the earliest event is due on, NEVER when nothing is pending
+		uint64_t nextTime() const { return count ? heap[0].when : NEVER; }
+		// removes and returns the earliest event
+		enum event pop();
+
+	private:
+		struct entry {
+			uint64_t when;
+			enum event type;
+		};
+
+		entry heap[EVENT_COUNT];
+		// where each event sits in heap, -1 when it isn't pending
+		int position[EVENT_COUNT];
+		int count;
+
+		void swap(int, int);
+		void siftUp(int);
+		void siftDown(int);
+};
+
+#endif
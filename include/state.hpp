@@ -0,0 +1,85 @@
+#ifndef STATE_H
+#define STATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "constants.hpp"
+
+/*
+ * SAVE STATE FORMAT:
+
+ "SGBS"  magic
+ u32     version
+ u64     hash of the ROM the state was taken from (the ROM isn't stored)
+ u32     ROM size
+ chunks  4 character tag, u32 length, length bytes of data
+
+ Numbers are little endian. Each component writes & reads its own chunk,
+ readers look chunks up by tag so chunks can be added without breaking
+ older states. The version goes up when a chunk's layout changes & states
+ of other versions are refused.
+*/
+
+static const uint32_t STATE_VERSION = 3;
+
+class StateWriter
+{
+	public:
+		// appends to out, which keeps its capacity between saves
+		StateWriter(std::vector<BYTE>& out) : out(out), chunkStart(0) {};
+
+		void writeHeader(uint64_t romHash, uint32_t romSize);
+		void beginChunk(const char* tag);
+		void endChunk();
+
+		void write8(BYTE value) { out.push_back(value); }
+		void write16(WORD value);
+		void write32(uint32_t value);
+		void write64(uint64_t value);
+		void writeBytes(const void* data, size_t length);
+
+	private:
+		std::vector<BYTE>& out;
+		size_t chunkStart;
+};
+
+/*
+ * Reads go through the open chunk & never past its end. A short or missing
+ * chunk reads as zeros & clears ok, so loaders check once at the end.
+ */
+class StateReader
+{
+	public:
+		StateReader(const BYTE* data, size_t length);
+
+		// header checks, false if this isn't a state of this version
+		bool readHeader(uint64_t& romHash, uint32_t& romSize);
+		bool hasChunk(const char* tag);
+		bool openChunk(const char* tag);
+		// bytes left in the open chunk
+		size_t remaining() const { return end - position; }
+		bool ok() const { return good; }
+
+		BYTE read8();
+		WORD read16();
+		uint32_t read32();
+		uint64_t read64();
+		void readBytes(void* data, size_t length);
+
+	private:
+		const BYTE* data;
+		size_t length;
+		// start of the first chunk
+		size_t chunks;
+		size_t position;
+		size_t end;
+		bool good;
+
+		bool findChunk(const char* tag, size_t& start, size_t& chunkLength);
+};
+
+// 64 bit FNV-1a, identifies the ROM a state belongs to
+uint64_t hashBytes(const BYTE* data, size_t length);
+
+#endif
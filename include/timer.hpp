@@ -1,24 +1,57 @@
 #ifndef TIMER_H
 #define TIMER_H
 
+#include <cstdint>
 #include "constants.hpp"
+#include "MMU.hpp"
+#include "state.hpp"
 
+/*
+ * DIV, TIMA, TMA & TAC. Nothing is counted as time passes: DIV & TIMA are
+ * worked out from the cycle they were last set on when read, so the timer
+ * only has work to do when it's written & when TIMA overflows. now is the
+ * emulator's cycle count since power on.
+ */
 class Timer
 {
 	public:
-		Timer();
+		static const uint64_t NEVER = UINT64_MAX;
+
+		Timer(MMU*);
 		virtual ~Timer() {};
 
-		void step(int);
 		void reset();
+
+		// FF04-FF07
+		BYTE read(WORD address, uint64_t now);
+		void write(WORD address, BYTE value, uint64_t now);
+
+		// reload TIMA & request the interrupt for every overflow due by now
+		void update(uint64_t now);
+		// cycle TIMA next overflows on, NEVER while the timer is off
+		uint64_t nextOverflow() const;
+
+		// "TIMR" chunk
+		void saveState(StateWriter&);
+		bool loadState(StateReader&);
 	private:
-		int timerCounter;
-		int dividerCounter;
-		int frequency;
+		Interrupts* interrupts;
+
+		// cycle the 16 bit counter behind DIV was last zero on
+		uint64_t divBase;
+		// TIMA as of the timaBase-th count since divBase
+		BYTE tima;
+		uint64_t timaBase;
+		BYTE tma;
+		BYTE tac;
 
-		void dividerRegister(int);
-		bool isTimerEnabled();
-		void setTimerFreq();
+		bool isEnabled() const { return tac & 0x04; }
+		// log2 of the cycles per TIMA count
+		int periodShift() const;
+		// TIMA counts since divBase, TIMA counts as bits of DIV's counter
+		// fall, so these line up with DIV
+		uint64_t counts(uint64_t now) const { return (now - divBase) >> periodShift(); }
+		BYTE currentTIMA(uint64_t now) const;
 };
 
-#endif
\ No newline at end of file
+#endif
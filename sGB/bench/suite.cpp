@@ -0,0 +1,671 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "CPU.hpp"
+#include "GPU.hpp"
+#include "perf.hpp"
+#include "sGBEmulator.hpp"
+#include "scanline.hpp"
+#include "timer.hpp"
+
+using namespace std;
+
+/*
+ * Micro benchmarks of the emulator's parts & whole frames of ROMs, one JSON
+ * object per line on stdout so runs on different commits can be diffed:
+ *
+ *   {"name":"mmu_read/wram","unit":"read","iterations":N,"seconds":S,"ns_per_op":T}
+ *
+ * Every benchmark is repeated with more iterations until it runs for at
+ * least --min-time seconds.
+ *
+ * usage: sGB_bench [--filter TEXT] [--min-time SECONDS] [--frames N] [rom path...]
+ */
+
+const char* ROM_PATH = "sGB_bench.gb";
+
+double minTime = 0.25;
+string filter;
+// results are folded in here so the compiler can't drop the work
+volatile uint64_t sink = 0;
+
+bool selected(const string& name)
+{
+	return filter.empty() || name.find(filter) != string::npos;
+}
+
+void report(const string& name, const char* unit, long long iterations, double seconds, const char* extra = "")
+{
+	printf("{\"name\":\"%s\",\"unit\":\"%s\",\"iterations\":%lld,\"seconds\":%.6f,\"ns_per_op\":%.3f%s}\n",
+		name.c_str(), unit, iterations, seconds, seconds * 1e9 / iterations, extra);
+	fflush(stdout);
+}
+
+/*
+ * body(iterations) does the work iterations times. The count grows from a
+ * short calibration run until a run takes at least minTime.
+ */
+template<typename Body>
+void bench(const string& name, const char* unit, Body body)
+{
+	if (!selected(name))
+	{
+		return;
+	}
+
+	long long iterations = 1000;
+	double seconds = 0;
+	while (true)
+	{
+		auto start = chrono::steady_clock::now();
+		body(iterations);
+		chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+		seconds = elapsed.count();
+
+		if (seconds >= minTime)
+		{
+			break;
+		}
+		// aim a little past minTime so the next run is normally the last
+		iterations = seconds > minTime / 100 ? (long long) (iterations * minTime * 1.2 / seconds) : iterations * 10;
+	}
+	report(name, unit, iterations, seconds);
+}
+
+/*
+ * A 64kB MBC1 image with 8kB of RAM whose entry point is program, which
+ * has to loop forever, normally with a jump back to 0100.
+ */
+bool writeBenchROM(const char* path, const vector<BYTE>& program)
+{
+	vector<BYTE> rom(0x10000, 0);
+	copy(program.begin(), program.end(), rom.begin() + 0x0100);
+	rom[ROM_TYPE_ADDRESS] = ROM_MBC1_RAM;
+	rom[ROM_SIZE_ADDRESS] = 0x01;
+	rom[RAM_SIZE_ADDRESS] = 0x02;
+	for (size_t i = 0x4000; i < rom.size(); i++)
+	{
+		rom[i] = i * 7;
+	}
+
+	ofstream out(path, ofstream::binary);
+	out.write((const char*) &rom[0], rom.size());
+	return out.good();
+}
+
+// count copies of an instruction then JR back to the top
+vector<BYTE> repeat(const vector<BYTE>& instruction, int count)
+{
+	vector<BYTE> program;
+	for (int i = 0; i < count; i++)
+	{
+		program.insert(program.end(), instruction.begin(), instruction.end());
+	}
+	program.push_back(0x18);
+	program.push_back((BYTE) -(int) (program.size() + 1));
+	return program;
+}
+
+// loads, ALU ops, CB-prefixed ops & a jump
+const vector<BYTE> MIX_PROGRAM = {
+	0x80,			// ADD A, B
+	0x0C,			// INC C
+	0xAA,			// XOR D
+	0x57,			// LD D, A
+	0x1D,			// DEC E
+	0xE6, 0x7F,		// AND 0x7F
+	0xB0,			// OR B
+	0xB9,			// CP C
+	0x23,			// INC HL
+	0xCB, 0x37,		// SWAP A
+	0xCB, 0x11,		// RL C
+	0x41,			// LD B, C
+	0x05,			// DEC B
+	0xA0,			// AND B
+	0x18, 0xEE		// JR 0100
+};
+const int MIX_INSTRUCTIONS = 16;
+
+/*
+ * 8 bit arithmetic, logic, rotates & shifts where only the JR NZ & PUSH AF
+ * read flags back, like most game code. Run on builds with SGB_LAZY_FLAGS
+ * on & off to compare the two.
+ */
+const vector<BYTE> ALU_PROGRAM = {
+	0x3E, 0x12,		// LD A, 0x12
+	0x06, 0x34,		// LD B, 0x34
+	0x0E, 0x56,		// LD C, 0x56
+	0x80,			// loop: ADD A, B
+	0x89,			// ADC A, C
+	0x92,			// SUB D
+	0x9B,			// SBC A, E
+	0x04,			// INC B
+	0x0D,			// DEC C
+	0xAD,			// XOR L
+	0xB8,			// CP B
+	0xE6, 0xF7,		// AND 0xF7
+	0xB4,			// OR H
+	0x07,			// RLCA
+	0xCB, 0x11,		// RL C
+	0xCB, 0x19,		// RR C
+	0xCB, 0x20,		// SLA B
+	0xCB, 0x38,		// SRL B
+	0x1C,			// INC E
+	0x15,			// DEC D
+	0x85,			// ADD A, L
+	0x20, 0xE7,		// JR NZ loop
+	0xF5,			// PUSH AF
+	0xF1,			// POP AF
+	0x18, 0xE3		// JR loop
+};
+
+// nearly every instruction reads or writes flags, the worst case for lazy flags
+const vector<BYTE> FLAGS_PROGRAM = {
+	0x37,			// SCF
+	0x17,			// RLA
+	0x3F,			// CCF
+	0x1F,			// RRA
+	0xCE, 0x01,		// ADC A, 0x01
+	0xDE, 0x02,		// SBC A, 0x02
+	0x38, 0x00,		// JR C, next
+	0x30, 0x00,		// JR NC, next
+	0x27,			// DAA
+	0x2F,			// CPL
+	0x05,			// DEC B
+	0xF5,			// PUSH AF
+	0xF1,			// POP AF
+	0x8F,			// ADC A, A
+	0x9F,			// SBC A, A
+	0x20, 0xEB,		// JR NZ 0100
+	0x18, 0xE9		// JR 0100
+};
+
+// instructions & cycles around the loop once, stepping it from the top
+int loopCycles(int instructions)
+{
+	CPU cpu;
+	cpu.loadROM(ROMImage::open(ROM_PATH));
+
+	int cycles = 0;
+	for (int i = 0; i < instructions; i++)
+	{
+		cycles += cpu.step();
+	}
+	return cycles;
+}
+
+/*
+ * CPU::run through the block cache, iterations instructions of a loop of
+ * instructions instructions taking cycles cycles
+ */
+void runInstructions(CPU& cpu, long long iterations, int instructions, int cycles)
+{
+	long long target = iterations / instructions * cycles;
+	for (long long done = 0; done < target; )
+	{
+		int taken = cpu.run(MAXCYCLES);
+		if (taken < 0)
+		{
+			cerr << "Error: stopped on unimplemented instruction" << endl;
+			exit(1);
+		}
+		done += taken;
+	}
+}
+
+void benchMMU()
+{
+	CPU cpu;
+	cpu.loadROM(ROMImage::open(ROM_PATH));
+	MMU& mmu = *cpu.getMMU();
+	// enable cartridge RAM
+	mmu.writeByte(0x0000, 0x0A);
+
+	/*
+	 * Addresses wrap within each region. Writes to ROM are the bank
+	 * controller's registers: 2000 selects the ROM bank & 4000 the RAM
+	 * bank, so they time bank switches.
+	 */
+	static const struct {
+		WORD read;
+		WORD write;
+		WORD mask;
+	} regions[REGION_COUNT] = {
+		{0x0000, 0x2000, 0x0000},
+		{0x4000, 0x4000, 0x0000},
+		{0x8000, 0x8000, 0x1fff},
+		{0xa000, 0xa000, 0x1fff},
+		{0xc000, 0xc000, 0x1fff},
+		{0xe000, 0xe000, 0x0fff},
+		{0xfe00, 0xfe00, 0x007f},
+		{0xff10, 0xff10, 0x001f},
+		{0xff80, 0xff80, 0x003f}
+	};
+
+	for (int region = 0; region < REGION_COUNT; region++)
+	{
+		WORD read = regions[region].read;
+		WORD write = regions[region].write;
+		WORD mask = regions[region].mask ? regions[region].mask : 0x3fff;
+
+		bench(string("mmu_read/") + memoryRegionNames[region], "read", [&](long long iterations) {
+			unsigned int sum = 0;
+			for (long long i = 0; i < iterations; i++)
+			{
+				sum += mmu.readByte(read + (i & mask));
+			}
+			sink += sum;
+		});
+
+		mask = regions[region].mask;
+		bench(string("mmu_write/") + memoryRegionNames[region], "write", [&](long long iterations) {
+			for (long long i = 0; i < iterations; i++)
+			{
+				mmu.writeByte(write + (i & mask), (BYTE) (i & 3) + 1);
+			}
+		});
+	}
+
+	// streaming code mostly re-selects the bank that's already mapped
+	mmu.writeByte(0x2000, 0x01);
+	bench("mmu_write/same_bank", "write", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			mmu.writeByte(0x2000, 0x01);
+		}
+	});
+	mmu.writeByte(0x4000, 0x00);
+}
+
+void benchALU()
+{
+	static const struct {
+		const char* name;
+		vector<BYTE> instruction;
+	} ops[] = {
+		{"add", {0x80}},		// ADD A, B
+		{"adc", {0x88}},		// ADC A, B
+		{"sub", {0x90}},		// SUB B
+		{"sbc", {0x98}},		// SBC A, B
+		{"and", {0xA0}},		// AND B
+		{"xor", {0xA8}},		// XOR B
+		{"or", {0xB0}},			// OR B
+		{"cp", {0xB8}},			// CP B
+		{"inc", {0x04}},		// INC B
+		{"dec", {0x05}},		// DEC B
+		{"add_hl", {0x09}},		// ADD HL, BC
+		{"daa", {0x27}},		// DAA
+		{"rl", {0xCB, 0x11}},	// RL C
+		{"swap", {0xCB, 0x37}},	// SWAP A
+		{"bit", {0xCB, 0x47}}	// BIT 0, A
+	};
+	const int COPIES = 30;
+
+	for (size_t op = 0; op < sizeof(ops) / sizeof(ops[0]); op++)
+	{
+		string name = string("alu/") + ops[op].name;
+		if (!selected(name))
+		{
+			continue;
+		}
+		if (!writeBenchROM(ROM_PATH, repeat(ops[op].instruction, COPIES)))
+		{
+			cerr << "Error writing " << ROM_PATH << endl;
+			exit(1);
+		}
+
+		int cycles = loopCycles(COPIES + 1);
+		CPU cpu;
+		cpu.loadROM(ROMImage::open(ROM_PATH));
+		bench(name, "instruction", [&](long long iterations) {
+			runInstructions(cpu, iterations, COPIES + 1, cycles);
+		});
+	}
+}
+
+// CPU::step through program, which branches too much to time in blocks
+void benchStepping(const string& name, const vector<BYTE>& program)
+{
+	if (!selected(name))
+	{
+		return;
+	}
+	if (!writeBenchROM(ROM_PATH, program))
+	{
+		cerr << "Error writing " << ROM_PATH << endl;
+		exit(1);
+	}
+
+	CPU cpu;
+	cpu.loadROM(ROMImage::open(ROM_PATH));
+	bench(name, "instruction", [&](long long iterations) {
+		long long cycles = 0;
+		for (long long i = 0; i < iterations; i++)
+		{
+			int taken = cpu.step();
+			if (taken < 0)
+			{
+				cerr << "Error: stopped on unimplemented instruction" << endl;
+				exit(1);
+			}
+			cycles += taken;
+		}
+		sink += cycles;
+	});
+}
+
+void benchDispatch()
+{
+	if (!writeBenchROM(ROM_PATH, MIX_PROGRAM))
+	{
+		cerr << "Error writing " << ROM_PATH << endl;
+		exit(1);
+	}
+
+	static const struct {
+		const char* name;
+		int (CPU::*step)();
+	} cores[] = {
+		{"cpu/step", &CPU::step},
+		{"cpu/step_table", &CPU::stepTable},
+		{"cpu/step_switch", &CPU::stepSwitch}
+	};
+
+	for (size_t core = 0; core < sizeof(cores) / sizeof(cores[0]); core++)
+	{
+		CPU cpu;
+		cpu.loadROM(ROMImage::open(ROM_PATH));
+		int (CPU::*step)() = cores[core].step;
+		bench(cores[core].name, "instruction", [&](long long iterations) {
+			long long cycles = 0;
+			for (long long i = 0; i < iterations; i++)
+			{
+				cycles += (cpu.*step)();
+			}
+			sink += cycles;
+		});
+	}
+
+	int cycles = loopCycles(MIX_INSTRUCTIONS);
+	CPU cpu;
+	cpu.loadROM(ROMImage::open(ROM_PATH));
+	bench("cpu/run_blocks", "instruction", [&](long long iterations) {
+		runInstructions(cpu, iterations, MIX_INSTRUCTIONS, cycles);
+	});
+}
+
+void benchTimer()
+{
+	CPU cpu;
+	Timer timer(cpu.getMMU());
+	// enabled at 262144Hz, TIMA counts up every 16 cycles
+	timer.write(TMC, 0x05, 0);
+	uint64_t now = 0;
+
+	bench("timer/read_tima", "read", [&](long long iterations) {
+		unsigned int sum = 0;
+		for (long long i = 0; i < iterations; i++)
+		{
+			now += 4;
+			timer.update(now);
+			sum += timer.read(TIMA, now);
+		}
+		sink += sum;
+	});
+	// the way the scheduler drives it
+	bench("timer/overflow", "overflow", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			now = timer.nextOverflow();
+			timer.update(now);
+		}
+	});
+	bench("timer/write_tac", "write", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			now += 4;
+			timer.write(TMC, 0x04 | (i & 3), now);
+		}
+	});
+	sink += timer.read(TIMA, now);
+}
+
+/*
+ * Random tiles, a background & window over them & all 40 sprites spread
+ * down the screen
+ */
+void benchScanline()
+{
+	CPU cpu;
+	MMU* mmu = cpu.getMMU();
+	GPU gpu(mmu);
+
+	srand(1);
+	for (WORD address = 0x8000; address < 0xa000; address++)
+	{
+		mmu->writeByte(address, rand() & 0xff);
+	}
+	for (int sprite = 0; sprite < 40; sprite++)
+	{
+		mmu->writeByte(0xfe00 + sprite * 4, 16 + sprite * 4);
+		mmu->writeByte(0xfe01 + sprite * 4, 8 + sprite * 13 % 160);
+		mmu->writeByte(0xfe02 + sprite * 4, sprite);
+		mmu->writeByte(0xfe03 + sprite * 4, (sprite & 3) << 5);
+	}
+	mmu->writeByte(WY, 80);
+	mmu->writeByte(WX, 87);
+	mmu->writeByte(LCDC, 0xB3);
+
+	// 154 lines a frame, 10 of them vblank
+	bench("gpu/line", "line", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			gpu.step(456);
+		}
+	});
+	sink += gpu.getFramebuffer()[SCREEN_WIDTH * 100];
+
+	BYTE background[SCREEN_WIDTH];
+	BYTE sprites[SCREEN_WIDTH];
+	PIXEL colours[12];
+	PIXEL line[SCREEN_WIDTH];
+	for (int x = 0; x < SCREEN_WIDTH; x++)
+	{
+		background[x] = rand() & 0x03;
+		sprites[x] = (x % 40 < 16) ? rand() & 0x0f : 0;
+	}
+	for (int i = 0; i < 12; i++)
+	{
+		colours[i] = 0xFF000000 | (i * 0x151515);
+	}
+
+	// the SIMD kernels have to match the plain ones pixel for pixel
+	const BYTE* vram = mmu->getVRAM();
+	PIXEL expected[SCREEN_WIDTH];
+	composeScanlineScalar(background, sprites, colours, expected, SCREEN_WIDTH);
+	composeScanline(background, sprites, colours, line, SCREEN_WIDTH);
+	bool same = memcmp(expected, line, sizeof(line)) == 0;
+	for (int t = 0; t < 384; t++)
+	{
+		BYTE want[64];
+		BYTE got[64];
+		decodeTileScalar(vram + t * 16, want);
+		decodeTile(vram + t * 16, got);
+		same = same && memcmp(want, got, sizeof(got)) == 0;
+	}
+	if (!same)
+	{
+		cerr << "Error: " << scanlineKernel() << " kernels don't match the scalar output" << endl;
+		exit(1);
+	}
+
+	bench(string("scanline/compose_") + scanlineKernel(), "line", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			composeScanline(background, sprites, colours, line, SCREEN_WIDTH);
+			sink += line[i % SCREEN_WIDTH];
+		}
+	});
+	bench("scanline/compose_scalar", "line", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			composeScanlineScalar(background, sprites, colours, line, SCREEN_WIDTH);
+			sink += line[i % SCREEN_WIDTH];
+		}
+	});
+
+	BYTE tile[64];
+	bench("scanline/decode_tile", "tile", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			decodeTile(vram + (i % 384) * 16, tile);
+			sink += tile[i & 63];
+		}
+	});
+	bench("scanline/decode_tile_scalar", "tile", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			decodeTileScalar(vram + (i % 384) * 16, tile);
+			sink += tile[i & 63];
+		}
+	});
+}
+
+/*
+ * Whole frames through sGBEmulator::update, speed is relative to a real
+ * Game Boy
+ */
+void benchFrames(const string& name, const string& path, long long frames)
+{
+	if (!selected(name))
+	{
+		return;
+	}
+	if (!ROMImage::open(path))
+	{
+		cerr << "Error opening " << path << endl;
+		return;
+	}
+
+	sGBEmulator emulator(path);
+	auto start = chrono::steady_clock::now();
+	for (long long i = 0; i < frames; i++)
+	{
+		if (!emulator.update())
+		{
+			cerr << name << ": stopped on unimplemented instruction" << endl;
+			return;
+		}
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+	char speed[64];
+	snprintf(speed, sizeof(speed), ",\"realtime\":%.2f", frames / (double) REFRESHRATE / elapsed.count());
+	report(name, "frame", frames, elapsed.count(), speed);
+}
+
+void benchState()
+{
+	sGBEmulator emulator(ROM_PATH);
+	emulator.update();
+
+	vector<BYTE> state;
+	bench("state/save", "state", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			emulator.saveState(state);
+		}
+	});
+	bench("state/load", "state", [&](long long iterations) {
+		for (long long i = 0; i < iterations; i++)
+		{
+			sink += emulator.loadState(state);
+		}
+	});
+}
+
+string baseName(const string& path)
+{
+	size_t slash = path.find_last_of("/\\");
+	return slash == string::npos ? path : path.substr(slash + 1);
+}
+
+int main(int argc, char** argv)
+{
+	long long frames = 10 * REFRESHRATE;
+	vector<string> roms;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+		{
+			filter = argv[++i];
+		}
+		else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc)
+		{
+			minTime = atof(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+		{
+			frames = atoll(argv[++i]);
+		}
+		else if (argv[i][0] == '-')
+		{
+			cerr << "Usage: " << argv[0] << " [--filter TEXT] [--min-time SECONDS] [--frames N] [rom path...]" << endl;
+			return 1;
+		}
+		else
+		{
+			roms.push_back(argv[i]);
+		}
+	}
+
+	// the emulator's progress messages would get mixed into the results
+	cout.setstate(ios::failbit);
+
+	printf("{\"suite\":\"sGB_bench\",\"switch_dispatch\":%s,\"lazy_flags\":%s,\"jit\":%s,\"scanline_kernel\":\"%s\"}\n",
+#ifdef SGB_SWITCH_DISPATCH
+		"true",
+#else
+		"false",
+#endif
+#ifdef SGB_LAZY_FLAGS
+		"true",
+#else
+		"false",
+#endif
+#ifdef SGB_JIT
+		"true",
+#else
+		"false",
+#endif
+		scanlineKernel());
+
+	if (!writeBenchROM(ROM_PATH, MIX_PROGRAM))
+	{
+		cerr << "Error writing " << ROM_PATH << endl;
+		return 1;
+	}
+	benchMMU();
+	benchTimer();
+	benchScanline();
+	benchDispatch();
+	benchFrames("frame/mix", ROM_PATH, frames);
+	benchState();
+	benchALU();
+	benchStepping("alu/mix", ALU_PROGRAM);
+	benchStepping("alu/flags", FLAGS_PROGRAM);
+	remove(ROM_PATH);
+
+	for (size_t i = 0; i < roms.size(); i++)
+	{
+		benchFrames("rom/" + baseName(roms[i]), roms[i], frames);
+	}
+	return 0;
+}
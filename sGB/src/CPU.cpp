@@ -1,59 +1,668 @@
 #include "CPU.hpp"
-#include <iostream>
+#include <cstdlib>
 #include <cstring>
+#include <iostream>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
 
 using namespace std;
 
+constexpr struct CPU::instruction CPU::instructionsTable[256];
+constexpr struct CPU::instruction CPU::extendedInstructions[256];
+constexpr struct CPU::instructionInfo CPU::instructionsInfo[256];
+constexpr struct CPU::instructionInfo CPU::extendedInfo[256];
+
 CPU::CPU() : 
-registers(new Registers()),
-mmu(new MMU()),
-clock(new Clock())
+registers(),
+mmu(),
+clock(),
+runStart(0),
+runEnd(0),
+halted(false),
+imeDelayed(false)
+#ifdef SGB_PERF_COUNTERS
+,
+instructions(0)
+#endif
+#ifdef SGB_JIT
+,
+jitRunMode(JIT_OFF),
+jitMismatches(0)
+#endif
 {
 	reset();
 }
 
+void* CPU::operator new(size_t size)
+{
+	void* memory = NULL;
+#ifdef _WIN32
+	memory = _aligned_malloc(size, alignof(CPU));
+#else
+	if (posix_memalign(&memory, alignof(CPU), size) != 0) {
+		memory = NULL;
+	}
+#endif
+	if (!memory) {
+		throw bad_alloc();
+	}
+	return memory;
+}
+
+void CPU::operator delete(void* memory)
+{
+#ifdef _WIN32
+	_aligned_free(memory);
+#else
+	free(memory);
+#endif
+}
+
+// Expand a case for every opcode in [n, n + 64) so each one gets its own
+// instantiation of the handler, letting the compiler inline it. call is a
+// macro taking the opcode.
+#define OPCODE_CASE_1(call, n) case (n): return call(n);
+#define OPCODE_CASE_4(call, n) OPCODE_CASE_1(call, n) OPCODE_CASE_1(call, n + 1) OPCODE_CASE_1(call, n + 2) OPCODE_CASE_1(call, n + 3)
+#define OPCODE_CASE_16(call, n) OPCODE_CASE_4(call, n) OPCODE_CASE_4(call, n + 4) OPCODE_CASE_4(call, n + 8) OPCODE_CASE_4(call, n + 12)
+#define OPCODE_CASE_64(call, n) OPCODE_CASE_16(call, n) OPCODE_CASE_16(call, n + 16) OPCODE_CASE_16(call, n + 32) OPCODE_CASE_16(call, n + 48)
+#define OPCODE_CASES(call) OPCODE_CASE_64(call, 0x00) OPCODE_CASE_64(call, 0x40) OPCODE_CASE_64(call, 0x80) OPCODE_CASE_64(call, 0xC0)
+
+#define EXECUTE(n) execute<(n)>()
+#define EXECUTE_EXTENDED(n) executeExtended<(n)>()
+#define EXECUTE_DECODED(n) executeDecoded<(n)>(decoded.operand)
+
+/*
+ * Read the operand of the current instruction & move PC past it, so
+ * handlers always see PC pointing at the next instruction.
+ */
+inline WORD CPU::fetchOperand(BYTE length)
+{
+	WORD operand = 0;
+	switch(length)
+	{
+		case 1:
+			operand = mmu.readByte(registers.pc);
+			break;
+		case 2:
+			operand = mmu.readWord(registers.pc);
+			break;
+	}
+
+	registers.pc += length;
+	return operand;
+}
+
+int CPU::unimplemented(BYTE instr)
+{
+	cout << "PC: " << hex((registers.pc - 1) >> 8) << hex(registers.pc - 1) <<  endl;
+	cout << "Instruction '" << instructionsInfo[instr].assembly << "' not implemented." << endl;
+	cout << "Description: " << instructionsInfo[instr].description << endl; 
+	return -1;
+}
+
 int CPU::step()
+{
+	if (halted)
+	{
+		if (!interruptRequested())
+		{
+			clock.advance(4);
+			return 4;
+		}
+		halted = false;
+	}
+
+#ifdef SGB_PROFILE
+	WORD pc = registers.pc;
+	int opcode = mmu.readByte(pc);
+	if (opcode == 0xCB)
+	{
+		opcode = 0x100 | mmu.readByte(pc + 1);
+	}
+	uint64_t startCycles = clock.now();
+#endif
+
+#ifdef SGB_SWITCH_DISPATCH
+	int cycles = stepSwitch();
+#else
+	int cycles = stepTable();
+#endif
+
+#ifdef SGB_PROFILE
+	if (cycles >= 0)
+	{
+		profileInstruction(pc, opcode, startCycles);
+	}
+#endif
+	return cycles;
+}
+
+/*
+ * Dispatch through the member function pointer stored in the opcode table.
+ */
+int CPU::stepTable()
 {
 	// Fetch next instruction & increment counter
-	BYTE instr = mmu->readByte(registers->pc++);
+	BYTE instr = mmu.readByte(registers.pc++);
 
 	// Decode instruction
-	struct instruction instruction = instructionsTable[instr];
+	const struct instruction& instruction = instructionsTable[instr];
 
 	// Execute instruction
 	if (instruction.func != NULL){
-		switch(instruction.operandLength)
+		(this->*(instruction.func))(fetchOperand(instruction.operandLength));
+
+		clock.advance(instruction.cycles);
+		return instruction.cycles;
+	} else
+	{
+		return unimplemented(instr);
+	}
+}
+
+/*
+ * Same table, but every entry is resolved at compile time so the switch
+ * jumps straight into an inlined copy of the handler.
+ */
+template<BYTE N>
+inline int CPU::execute()
+{
+	// operand length is a constant here, so only the needed read survives
+	WORD operand = 0;
+	if (instructionsTable[N].operandLength == 1)
+	{
+		operand = mmu.readByte(registers.pc);
+	}
+	else if (instructionsTable[N].operandLength == 2)
+	{
+		operand = mmu.readWord(registers.pc);
+	}
+	registers.pc += instructionsTable[N].operandLength;
+
+	return executeDecoded<N>(operand);
+}
+
+// Run an instruction whose operand has been read & PC moved past it
+template<BYTE N>
+inline int CPU::executeDecoded(WORD operand)
+{
+	if (instructionsTable[N].func == NULL)
+	{
+		return unimplemented(N);
+	}
+
+	(this->*(instructionsTable[N].func))(operand);
+
+	clock.advance(instructionsTable[N].cycles);
+	return instructionsTable[N].cycles;
+}
+
+int CPU::stepSwitch()
+{
+	BYTE instr = mmu.readByte(registers.pc++);
+
+	switch(instr)
+	{
+		OPCODE_CASES(EXECUTE)
+	}
+
+	return -1;
+}
+
+template<BYTE N>
+inline void CPU::executeExtended()
+{
+	(this->*(extendedInstructions[N].func))(0);
+	clock.advance(extendedInstructions[N].cycles - 8);
+}
+
+void CPU::stepExtended(BYTE instr)
+{
+#ifdef SGB_SWITCH_DISPATCH
+	switch(instr)
+	{
+		OPCODE_CASES(EXECUTE_EXTENDED)
+	}
+#else
+	(this->*(extendedInstructions[instr].func))(0);
+	clock.advance(extendedInstructions[instr].cycles - 8);
+#endif
+}
+
+int CPU::run(int budget)
+{
+	runStart = clock.now();
+	runEnd = runStart + budget;
+
+	while (clock.now() < runEnd)
+	{
+		if (mmu.getInterrupts().pending())
 		{
-			case 0:
-				(this->*(instruction.func))(0);
-				break;
-			case 1:
-				(this->*(instruction.func))(mmu->readByte(registers->pc));
-				break;
-			case 2:
-				(this->*(instruction.func))(mmu->readWord(registers->pc));
+			interrupt();
+		}
+
+		if (halted)
+		{
+			if (!interruptRequested())
+			{
+				// idle straight to the end, nothing runs to request one
+				if (clock.now() < runEnd)
+				{
+					clock.advance((int) (runEnd - clock.now()));
+				}
 				break;
+			}
+			halted = false;
 		}
 
-		registers->pc += instruction.operandLength;
-		clock->updateClocks(instruction.cycles);
-		return instruction.cycles;
+		if (imeDelayed)
+		{
+			// IME is on once the instruction after EI is done, which runs
+			// on its own so nothing is taken before then. DI undoes it.
+			imeDelayed = false;
+			mmu.getInterrupts().setIME(true);
+
+			if (step() < 0)
+			{
+				return -1;
+			}
+#ifdef SGB_PERF_COUNTERS
+			instructions++;
+#endif
+			continue;
+		}
+
+		if (registers.pc < 0x8000)
+		{
+			block* decoded = findBlock();
+			if (decoded->count > 0)
+			{
+				int first = 0;
+				int last = decoded->count;
+#ifdef SGB_JIT
+				first = runNative(decoded, last);
+#endif
+				// the interpreter picks up wherever native code stopped
+				if (first < last && clock.now() < runEnd)
+				{
+					executeBlock(decoded, first, last);
+				}
+				continue;
+			}
+		}
+
+		// RAM code & anything a block can't start with, one at a time
+		if (step() < 0)
+		{
+			return -1;
+		}
+#ifdef SGB_PERF_COUNTERS
+		instructions++;
+#endif
+	}
+
+	return (int) (clock.now() - runStart);
+}
+
+int CPU::interrupt()
+{
+	Interrupts& interrupts = mmu.getInterrupts();
+	if (!interrupts.pending())
+	{
+		return 0;
+	}
+
+	halted = false;
+	WORD handler = interrupts.acknowledge();
+	writeStack(registers.pc);
+	registers.pc = handler;
+	profileCall();
+
+	// two wait states, the push & the jump
+	clock.advance(20);
+	return 20;
+}
+
+bool CPU::endsBlock(BYTE instr)
+{
+	switch(instr)
+	{
+		// jumps
+		case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+		case 0xC2: case 0xC3: case 0xCA: case 0xD2: case 0xDA: case 0xE9:
+		// calls & returns
+		case 0xC4: case 0xCC: case 0xCD: case 0xD4: case 0xDC:
+		case 0xC0: case 0xC8: case 0xC9: case 0xD0: case 0xD8: case 0xD9:
+		// restarts
+		case 0xC7: case 0xCF: case 0xD7: case 0xDF: case 0xE7: case 0xEF: case 0xF7: case 0xFF:
+		// stop, halt & interrupt enable/disable
+		case 0x10: case 0x76: case 0xF3: case 0xFB:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/*
+ * Block starting at PC in the bank mapped there, decoded on first use.
+ * Blocks stop before unimplemented opcodes & the end of the 16kB bank.
+ */
+block* CPU::findBlock()
+{
+	WORD pc = registers.pc;
+	unsigned int bank = mmu.romBankAt(pc);
+
+	if (bank >= blocks.size())
+	{
+		blocks.resize(bank + 1);
+	}
+	if (blocks[bank].empty())
+	{
+		blocks[bank].resize(0x4000);
+	}
+
+	unique_ptr<block>& cached = blocks[bank][pc & 0x3fff];
+	if (cached)
+	{
+		return cached.get();
+	}
+
+	cached.reset(new block());
+	block* decoded = cached.get();
+	decoded->count = 0;
+#ifdef SGB_JIT
+	decoded->runs = 0;
+	decoded->native = NULL;
+	decoded->nativeCount = 0;
+	decoded->nativeCycles = 0;
+	decoded->nativePC = 0;
+#endif
+
+	int address = pc;
+	int bankEnd = (pc & 0xc000) + 0x4000;
+	while (decoded->count < MAX_BLOCK)
+	{
+		BYTE opcode = mmu.readByte(address);
+		const struct instruction& instruction = instructionsTable[opcode];
+		int length = 1 + instruction.operandLength;
+
+		if (instruction.func == NULL || address + length > bankEnd)
+		{
+			break;
+		}
+
+		decodedInstruction& entry = decoded->instructions[decoded->count++];
+		entry.opcode = opcode;
+		entry.length = length;
+		entry.operand = 0;
+		if (length == 2) {
+			entry.operand = mmu.readByte(address + 1);
+		} else if (length == 3) {
+			entry.operand = mmu.readWord(address + 1);
+		}
+
+		address += length;
+		if (endsBlock(opcode))
+		{
+			break;
+		}
+	}
+
+	return decoded;
+}
+
+inline int CPU::dispatchDecoded(const struct decodedInstruction& decoded)
+{
+	switch(decoded.opcode)
+	{
+		OPCODE_CASES(EXECUTE_DECODED)
+	}
+
+	return -1;
+}
+
+/*
+ * Runs instructions first up to last of the block, leaving early when the
+ * run is out of cycles or a bank switch remaps the ROM it came from.
+ */
+void CPU::executeBlock(const block* decoded, int first, int last)
+{
+	unsigned int romSwitches = mmu.getROMSwitches();
+
+	for (int i = first; i < last; i++)
+	{
+		const decodedInstruction& instruction = decoded->instructions[i];
+#ifdef SGB_PROFILE
+		WORD pc = registers.pc;
+		uint64_t startCycles = clock.now();
+#endif
+		registers.pc += instruction.length;
+
+#ifdef SGB_SWITCH_DISPATCH
+		dispatchDecoded(instruction);
+#else
+		const struct CPU::instruction& entry = instructionsTable[instruction.opcode];
+		(this->*(entry.func))(instruction.operand);
+		clock.advance(entry.cycles);
+#endif
+
+#ifdef SGB_PERF_COUNTERS
+		instructions++;
+#endif
+#ifdef SGB_PROFILE
+		int opcode = instruction.opcode == 0xCB ? 0x100 | (instruction.operand & 0xff) : instruction.opcode;
+		profileInstruction(pc, opcode, startCycles);
+#endif
+
+		if (clock.now() >= runEnd || mmu.getROMSwitches() != romSwitches)
+		{
+			break;
+		}
+	}
+}
+
+#ifdef SGB_JIT
+// runs through the interpreter before a block is worth compiling
+static const int JIT_THRESHOLD = 16;
+
+/*
+ * Run the block's native code if it has some, compiling it once it's hot.
+ * Returns how many instructions ran. When native code is in use the
+ * interpreter only steps over what stopped it & last is moved in, so the
+ * code after gets a block & native code of its own.
+ */
+int CPU::runNative(block* decoded, int& last)
+{
+	if (jitRunMode == JIT_OFF)
+	{
+		return 0;
+	}
+
+	if (decoded->native == NULL)
+	{
+		if (decoded->runs >= 0 && ++decoded->runs >= JIT_THRESHOLD)
+		{
+			BYTE cycles[MAX_BLOCK];
+			for (int i = 0; i < decoded->count; i++)
+			{
+				cycles[i] = instructionsTable[decoded->instructions[i].opcode].cycles;
+			}
+			if (!jit.compile(*decoded, registers.pc, cycles))
+			{
+				decoded->runs = -1;
+			}
+		}
+
+		if (decoded->native == NULL)
+		{
+			if (decoded->runs < 0 && !JIT::supports(decoded->instructions[0]))
+			{
+				last = 1;
+			}
+			return 0;
+		}
+	}
+
+	// native code can't stop part way, so all of it has to fit in the run
+	if (registers.pc != decoded->nativePC || clock.now() + decoded->nativeCycles >= runEnd)
+	{
+		return 0;
+	}
+
+	int count;
+	if (jitRunMode == JIT_VERIFY)
+	{
+		count = verifyNative(decoded);
 	} else
 	{
-		cout << "PC: " << hex((registers->pc - 1) >> 8) << hex(registers->pc - 1) <<  endl;
-		cout << "Instruction '" << instruction.assembly << "' not implemented." << endl;
-		cout << "Description: " << instruction.description << endl; 
-		return -1;
+		uint32_t result = decoded->native(&registers, &flags, mmu.getReadPages(), mmu.getWritePages());
+		clock.advance((result & 0xffff) + (result >> 24));
+		count = (result >> 16) & 0xff;
+#ifdef SGB_PERF_COUNTERS
+		instructions += count;
+#endif
+	}
+
+	if (count < last)
+	{
+		last = count + 1;
+	}
+	return count;
+}
+
+static void reportMismatch(WORD pc, const char* what, int native, int interpreted)
+{
+	cout << "JIT mismatch in block at " << std::hex << pc << ": " << what <<
+		" native " << native << " interpreter " << interpreted << std::dec << endl;
+}
+
+/*
+ * Run the native code, put everything back & run the same instructions on
+ * the interpreter, then compare. The interpreter's results are kept.
+ */
+int CPU::verifyNative(block* decoded)
+{
+	Registers before = registers;
+	lazyFlags flagsBefore = flags;
+	vector<BYTE> ram;
+	mmu.copyRAM(ram);
+
+	uint32_t result = decoded->native(&registers, &flags, mmu.getReadPages(), mmu.getWritePages());
+	int count = (result >> 16) & 0xff;
+	Registers native = registers;
+	BYTE nativeFlags = readFlags();
+	vector<BYTE> nativeRAM;
+	mmu.copyRAM(nativeRAM);
+
+	registers = before;
+	flags = flagsBefore;
+	mmu.restoreRAM(ram);
+	uint64_t start = clock.now();
+	executeBlock(decoded, 0, count);
+
+	bool match = true;
+	const struct { const char* name; int native; int interpreted; } checks[] = {
+		{ "A", native.af.b.b1, registers.af.b.b1 },
+		{ "F", nativeFlags, readFlags() },
+		{ "BC", native.bc.w, registers.bc.w },
+		{ "DE", native.de.w, registers.de.w },
+		{ "HL", native.hl.w, registers.hl.w },
+		{ "SP", native.sp, registers.sp },
+		{ "PC", native.pc, registers.pc },
+		{ "cycles", (int) ((result & 0xffff) + (result >> 24)), (int) (clock.now() - start) }
+	};
+	for (size_t i = 0; i < sizeof(checks) / sizeof(checks[0]); i++)
+	{
+		if (checks[i].native != checks[i].interpreted)
+		{
+			reportMismatch(before.pc, checks[i].name, checks[i].native, checks[i].interpreted);
+			match = false;
+		}
+	}
+
+	mmu.copyRAM(ram);
+	if (ram != nativeRAM)
+	{
+		size_t at = 0;
+		while (ram[at] == nativeRAM[at])
+		{
+			at++;
+		}
+		// offset into MMU::copyRAM's VRAM, cartridge RAM, WRAM
+		cout << "JIT mismatch in block at " << std::hex << before.pc << ": RAM offset " << at <<
+			" native " << (int) nativeRAM[at] << " interpreter " << (int) ram[at] << std::dec << endl;
+		match = false;
+	}
+
+	if (!match)
+	{
+		jitMismatches++;
+	}
+	return count;
+}
+
+bool CPU::setJITMode(enum jitMode mode)
+{
+#ifdef SGB_PROFILE
+	// native code would run without being counted
+	if (mode != JIT_OFF)
+	{
+		cout << "Error: the JIT can't be used while profiling" << endl;
+		return false;
 	}
+#endif
+	jitRunMode = mode;
+	return true;
 }
 
-void CPU::loadROM(ifstream &romFile)
+unsigned int CPU::getJITMismatches()
 {
-	char cartridgeInfo[0x014F];
-	romFile.read(cartridgeInfo, 0x014F);
+	return jitMismatches;
+}
+#else
+bool CPU::setJITMode(enum jitMode mode)
+{
+	if (mode != JIT_OFF)
+	{
+		cout << "Error: built without SGB_JIT" << endl;
+		return false;
+	}
+	return true;
+}
+
+unsigned int CPU::getJITMismatches()
+{
+	return 0;
+}
+#endif
+
+#ifdef SGB_PROFILE
+void CPU::writeProfile(ostream& report, ostream& stacks)
+{
+	vector<const char*> names;
+	for (int i = 0; i < 256; i++)
+	{
+		names.push_back(instructionsInfo[i].assembly);
+	}
+	for (int i = 0; i < 256; i++)
+	{
+		names.push_back(extendedInfo[i].assembly);
+	}
+
+	profiler.writeReport(report, names, 50);
+	profiler.writeCollapsed(stacks);
+}
+#endif
+
+void CPU::loadROM(shared_ptr<const ROMImage> rom)
+{
+	const BYTE* cartridgeInfo = rom->data();
 
 	BYTE romTypeVal = cartridgeInfo[ROM_TYPE_ADDRESS];
 	romType = romTypeNames[romTypeVal];
+	blocks.clear();
 	cout << "ROM type: " << romType << endl;
 
 	BYTE romSizeVal = cartridgeInfo[ROM_SIZE_ADDRESS];
@@ -69,8 +678,10 @@ void CPU::loadROM(ifstream &romFile)
 	}
 	cout << "ROM Name: " << romName << endl;
 
-	romFile.seekg(0, romFile.beg);
-	mmu->loadGame(romFile, romTypeVal);
+	mmu.loadGame(rom, romTypeVal);
+#ifdef SGB_PROFILE
+	profiler.reset(rom->size() / 0x4000);
+#endif
 }
 
 /*
@@ -78,465 +689,369 @@ void CPU::loadROM(ifstream &romFile)
  */
 void CPU::reset()
 {
-	mmu->reset();
+	mmu.reset();
+
+	registers.af.w = 0x01B0;
+	registers.bc.w = 0x0013;
+	registers.de.w = 0x00D8;
+	registers.hl.w = 0x014D;
+	writeFlags(registers.af.b.b2);
+
+	registers.pc = 0x0100;
+	registers.sp = 0xFFFE;
+	halted = false;
+	imeDelayed = false;
 
-	registers->af.w = 0x01B0;
-	registers->bc.w = 0x0013;
-	registers->de.w = 0x00D8;
-	registers->hl.w = 0x014D;
+	clock.reset();
+}
+
+/*
+ * F is saved as the game would see it, so states move between builds with
+ * & without lazy flags
+*/
+void CPU::saveState(StateWriter& writer)
+{
+	writer.beginChunk("CPU ");
+	writer.write8(registers.af.b.b1);
+	writer.write8(readFlags());
+	writer.write16(registers.bc.w);
+	writer.write16(registers.de.w);
+	writer.write16(registers.hl.w);
+	writer.write16(registers.sp);
+	writer.write16(registers.pc);
+	clock.saveState(writer);
+	writer.write8(halted);
+	writer.write8(mmu.getInterrupts().getIME());
+	writer.write8(imeDelayed);
+	writer.endChunk();
+}
 
-	registers->pc = 0x0100;
-	registers->sp = 0xFFFE;
+bool CPU::loadState(StateReader& reader)
+{
+	if (!reader.openChunk("CPU "))
+	{
+		return false;
+	}
 
-	clock->resetClocks();
+	registers.af.b.b1 = reader.read8();
+	registers.af.b.b2 = reader.read8();
+	writeFlags(registers.af.b.b2);
+	registers.bc.w = reader.read16();
+	registers.de.w = reader.read16();
+	registers.hl.w = reader.read16();
+	registers.sp = reader.read16();
+	registers.pc = reader.read16();
+	clock.loadState(reader);
+	halted = reader.read8();
+	mmu.getInterrupts().setIME(reader.read8());
+	imeDelayed = reader.read8();
+	return reader.ok();
 }
 
 void CPU::writeStack(WORD data)
 {
-	registers->sp -= 2;
-	mmu->writeWord(registers->sp, data);
+	registers.sp -= 2;
+	mmu.writeWord(registers.sp, data);
 }
 
 WORD CPU::popWordStack()
 {
-	WORD ret = mmu->readWord(registers->sp);
-	registers->sp += 2;
+	WORD ret = mmu.readWord(registers.sp);
+	registers.sp += 2;
 	return ret;
 }
 
 void CPU::ret_cc() 
 {
-	clock->updateClocks(12);
-	registers->pc = popWordStack();
+	clock.advance(12);
+	registers.pc = popWordStack();
+	profileReturn();
 }
 
 void CPU::jp_cc(WORD op)
 {
-	registers->pc = op;
-	clock->updateClocks(4);
+	registers.pc = op;
+	clock.advance(4);
 }
 
 void CPU::call_cc(WORD op)
 {
-	writeStack(registers->pc);
-	registers->pc = op;
-	clock->updateClocks(12);
+	writeStack(registers.pc);
+	registers.pc = op;
+	clock.advance(12);
+	profileCall();
 }
 
 void CPU::rst_h(WORD op)
 {
-	writeStack(registers->pc);
-	registers->pc = op;
+	writeStack(registers.pc);
+	registers.pc = op;
+	profileCall();
+}
+
+#ifdef SGB_LAZY_FLAGS
+BYTE CPU::readFlags()
+{
+	return (flags.zeroResult ? 0 : flag_z) | (flags.negative ? flag_n : 0) |
+		((flags.halfBits & 0x10) ? flag_h : 0) | ((flags.carryBits & 0x100) ? flag_c : 0);
+}
+
+void CPU::writeFlags(BYTE f)
+{
+	flags.zeroResult = (f & flag_z) ? 0 : 1;
+	flags.negative = f & flag_n;
+	flags.halfBits = (f & flag_h) ? 0x10 : 0;
+	flags.carryBits = (f & flag_c) ? 0x100 : 0;
+}
+#else
+BYTE CPU::readFlags()
+{
+	return registers.af.b.b2 & 0xf0;
 }
 
+void CPU::writeFlags(BYTE flags)
+{
+	// the low 4 bits of F always read back as 0
+	registers.af.b.b2 = flags & 0xf0;
+}
+#endif
+
 void CPU::add(BYTE& dest, BYTE value)
 {
-	flagClear(*registers, flag_n);
 	// use int incase of carry, if upper 8 bits are set
 	unsigned int sum = dest + value;
 
-	if(sum & 0xff00) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
-
-	if((dest & 0x0f) + (value & 0x0f) > 0x0f) {
-		flagSet(*registers, flag_h);
-	} else {
-		flagClear(*registers, flag_h);
-	}
-
-	if(dest) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(dest ^ value ^ sum);
+	setCarryFlag(sum);
+	setZeroFlag((BYTE) sum);
 
 	dest = (BYTE) sum & 0xff; // only want lower 8 bits
 }
 
 void CPU::addWord(WORD& dest, WORD value)
 {
-	flagClear(*registers, flag_n);
-
-	unsigned long sum = dest + value;
+	unsigned int sum = dest + value;
 
-	if(sum & 0xffff0000) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
-
-	if((dest & 0x0fff) + (value & 0x0fff) > 0x0fff) {
-		flagSet(*registers, flag_h);
-	} else {
-		flagClear(*registers, flag_h);
-	}
+	// carries out of bits 11 & 15, moved down to the 8 bit positions
+	setNegativeFlag(false);
+	setHalfFlag((dest ^ value ^ sum) >> 8);
+	setCarryFlag(sum >> 8);
 
 	dest = (WORD) sum & 0xffff;
 }
 
 void CPU::adc(BYTE value)
 {
-	flagClear(*registers, flag_n);
-
-	unsigned int sum = registers->af.b.b1 + value + (flagCarry(*registers)?1:0);
+	BYTE a = registers.af.b.b1;
+	unsigned int sum = a + value + (carryFlag()?1:0);
 
-	if(sum & 0xff00) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
-
-	if(sum) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
-
-	if((registers->af.b.b1 & 0x0f) + (value & 0x0f) > 0x0f) {
-		flagSet(*registers, flag_h);
-	} else {
-		flagClear(*registers, flag_h);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(a ^ value ^ sum);
+	setCarryFlag(sum);
+	setZeroFlag((BYTE) sum);
 
-	registers->af.b.b1 = (BYTE) sum & 0xff;
+	registers.af.b.b1 = (BYTE) sum & 0xff;
 }
 
 void CPU::subtract(BYTE value)
 {
-	flagSet(*registers, flag_n);
-
-	BYTE diff = registers->af.b.b1 - value;
-
-	if(diff) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
-
-	if(value > registers->af.b.b1) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
+	BYTE a = registers.af.b.b1;
+	// wraps on a borrow, setting bit 8 & up
+	unsigned int diff = a - value;
 
-	if((value & 0x0f) > (registers->af.b.b1 & 0x0f)) {
-		flagSet(*registers, flag_h);
-	} else {
-		flagClear(*registers, flag_h);
-	}
+	setNegativeFlag(true);
+	setHalfFlag(a ^ value ^ diff);
+	setCarryFlag(diff);
+	setZeroFlag((BYTE) diff);
 
-	registers->af.b.b1 = diff;
+	registers.af.b.b1 = (BYTE) diff;
 }
 
 void CPU::sbc(BYTE value)
 {
-	flagSet(*registers, flag_n);
-
-	value += (flagCarry(*registers)?1:0);
-	BYTE diff = registers->af.b.b1 - value;
-
-	if(diff) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
-
-	if(value > registers->af.b.b1) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
+	BYTE a = registers.af.b.b1;
+	unsigned int diff = a - value - (carryFlag()?1:0);
 
-	if((value & 0x0f) > (registers->af.b.b1 & 0x0f)) {
-		flagSet(*registers, flag_h);
-	} else {
-		flagClear(*registers, flag_h);
-	}
+	setNegativeFlag(true);
+	setHalfFlag(a ^ value ^ diff);
+	setCarryFlag(diff);
+	setZeroFlag((BYTE) diff);
 
-	registers->af.b.b1 = diff;
+	registers.af.b.b1 = (BYTE) diff;
 }
 
 void CPU::andd(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h | flag_c);
-
-	registers->af.b.b1 &= value;
+	registers.af.b.b1 &= value;
 
-	if(registers->af.b.b1) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(0x10);
+	setCarryFlag(0);
+	setZeroFlag(registers.af.b.b1);
 }
 
 void CPU::orr(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h | flag_c);
-
-	registers->af.b.b1 |= value;
+	registers.af.b.b1 |= value;
 
-	if(registers->af.b.b1) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(0);
+	setZeroFlag(registers.af.b.b1);
 }
 
 void CPU::xorr(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h | flag_c);
-
-	registers->af.b.b1 ^= value;
+	registers.af.b.b1 ^= value;
 
-	if(registers->af.b.b1) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(0);
+	setZeroFlag(registers.af.b.b1);
 }
 
+// subtract without keeping the result
 void CPU::cp(BYTE value)
 {
-	flagSet(*registers, flag_n);
-
-	if(value != registers->af.b.b1) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	BYTE a = registers.af.b.b1;
+	unsigned int diff = a - value;
 
-	if(value > registers->af.b.b1) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
-
-	if((value & 0x0f) > (registers->af.b.b1 & 0x0f)) {
-		flagSet(*registers, flag_h);
-	} else {
-		flagClear(*registers, flag_h);
-	}
+	setNegativeFlag(true);
+	setHalfFlag(a ^ value ^ diff);
+	setCarryFlag(diff);
+	setZeroFlag((BYTE) diff);
 }
 
+// carry is left alone
 BYTE CPU::increment(BYTE value)
 {
-	flagClear(*registers, flag_n); // reset neg
-	
-	bool halfCarry = value & 0x0f;
-	if(halfCarry) {
-		flagSet(*registers, flag_h);
-	} else {
-		flagClear(*registers, flag_h);
-	}
+	BYTE result = value + 1;
 
-	value++;
+	setNegativeFlag(false);
+	setHalfFlag(value ^ 1 ^ result);
+	setZeroFlag(result);
 
-	if(value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
-
-	return value;
+	return result;
 }
 
 BYTE CPU::decrement(BYTE value)
 {
-	flagSet(*registers, flag_n);
-
-	bool halfCarry = value & 0x0f;
-	if(halfCarry) {
-		flagClear(*registers, flag_h);
-	} else {
-		flagSet(*registers, flag_h);
-	}
+	BYTE result = value - 1;
 
-	value--;
-
-	if(value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	setNegativeFlag(true);
+	setHalfFlag(value ^ 1 ^ result);
+	setZeroFlag(result);
 
-	return value;
+	return result;
 }
 
+/*
+ * Rotates & shifts clear N & H, C gets the bit shifted out: value << 1
+ * moves bit 7 to bit 8, value << 8 moves bit 0 there
+ */
 BYTE CPU::rlc(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h);
-
-	if (value & 0x80) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
-
-	value = (value << 1) | (value >> 7);
+	BYTE result = (value << 1) | (value >> 7);
 
-	if (value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(value << 1);
+	setZeroFlag(result);
 
-	return value;
+	return result;
 }
 
 BYTE CPU::rrc(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h);
-
-	if (value & 0x01) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
+	BYTE result = (value >> 1) | (value << 7);
 
-	value = (value >> 1) | (value << 7);
-
-	if (value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(value << 8);
+	setZeroFlag(result);
 
-	return value;
+	return result;
 }
 
 BYTE CPU::rl(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h);
+	BYTE result = (value << 1) | (carryFlag() ? 1 : 0);
 
-	if (value & 0x80) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
-
-	value = (value << 1) | flagCarry(*registers) ? 1 : 0;
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(value << 1);
+	setZeroFlag(result);
 
-	if (value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
-
-	return value;
+	return result;
 }
 
 BYTE CPU::rr(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h);
+	BYTE result = (value >> 1) | (carryFlag() ? 0x80 : 0);
 
-	if (value & 0x01) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(value << 8);
+	setZeroFlag(result);
 
-	value = (value >> 1) | (value << 7);
-
-	if (value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
-
-	return value;
+	return result;
 }
 
 BYTE CPU::sla(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h);
-
-	if (value & 0x80) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
+	BYTE result = value << 1;
 
-	value <<= 1;
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(value << 1);
+	setZeroFlag(result);
 
-	if (value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
-
-	return value;
+	return result;
 }
 
 BYTE CPU::sra(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h);
+	BYTE result = (value >> 1) | (value & 0x80);
 
-	if (value & 0x01) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(value << 8);
+	setZeroFlag(result);
 
-	value = (value >> 1) | (value & 0x80);
-
-	if (value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
-
-	return value;
+	return result;
 }
 
 BYTE CPU::swap(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h | flag_c);
-
-	value = ((value & 0xf0) >> 4) | ((value & 0xf) << 4);
+	BYTE result = ((value & 0xf0) >> 4) | ((value & 0xf) << 4);
 
-	if (value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(0);
+	setZeroFlag(result);
 
-	return value;
+	return result;
 }
 
 BYTE CPU::srl(BYTE value)
 {
-	flagClear(*registers, flag_n | flag_h);
-
-	if (value & 0x01) {
-		flagSet(*registers, flag_c);
-	} else {
-		flagClear(*registers, flag_c);
-	}
+	BYTE result = value >> 1;
 
-	value >>= 1;
+	setNegativeFlag(false);
+	setHalfFlag(0);
+	setCarryFlag(value << 8);
+	setZeroFlag(result);
 
-	if (value) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
-
-	return value;
+	return result;
 }
 
+// carry is left alone
 void CPU::bit(BYTE check, BYTE value)
 {
-	flagClear(*registers, flag_n);
-	flagSet(*registers, flag_h);
-
-	if (value & check) {
-		flagClear(*registers, flag_z);
-	} else {
-		flagSet(*registers, flag_z);
-	}
+	setNegativeFlag(false);
+	setHalfFlag(0x10);
+	setZeroFlag(value & check);
 }
 
 BYTE CPU::set(BYTE check, BYTE value)
@@ -1,41 +1,393 @@
 #include "GPU.hpp"
+#include <cstring>
 
-GPU::GPU():
+// http://imrannazar.com/GameBoy-Emulation-in-JavaScript:-GPU-Timings
+const int OAM_CYCLES = 80;
+const int VRAM_CYCLES = 172;
+const int HBLANK_CYCLES = 204;
+const int LINE_CYCLES = 456;
+const int LAST_LINE = 153;
+
+// shades of grey for colours 0-3, lightest first
+static const PIXEL shades[4] = { 0xFFFFFFFF, 0xFFAAAAAA, 0xFF555555, 0xFF000000 };
+
+GPU::GPU(MMU* mmu):
+gpuMode(OAM),
+vram(mmu->getVRAM()),
+oam(mmu->getOAM()),
+io(mmu->getIO()),
+interrupts(&mmu->getInterrupts()),
+dirtyTiles(mmu->getDirtyTiles()),
+tilesDirty(mmu->getTilesDirty()),
 scanningCounter(0),
-gpuMode(HBLANK),
-currLine(0)
+currLine(0),
+windowLine(0)
 {
+	reset();
+}
 
+void GPU::reset()
+{
+	scanningCounter = 0;
+	windowLine = 0;
+	setLine(0);
+	setMode(OAM);
+
+	for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++)
+	{
+		framebuffer[i] = shades[0];
+	}
+	memset(dirtyRows, 1, sizeof(dirtyRows));
 }
 
-// http://imrannazar.com/GameBoy-Emulation-in-JavaScript:-GPU-Timings
+void GPU::saveState(StateWriter& writer)
+{
+	writer.beginChunk("GPU ");
+	writer.write8(gpuMode);
+	writer.write32(scanningCounter);
+	writer.write32(currLine);
+	writer.write32(windowLine);
+	writer.endChunk();
+}
+
+bool GPU::loadState(StateReader& reader)
+{
+	if (!reader.openChunk("GPU "))
+	{
+		return false;
+	}
+
+	gpuMode = (enum mode) (reader.read8() & 0x03);
+	scanningCounter = reader.read32();
+	currLine = reader.read32();
+	windowLine = reader.read32();
+	return reader.ok();
+}
+
+void GPU::saveFrame(StateWriter& writer)
+{
+	writer.beginChunk("FRAM");
+	// pixels go as is, in host byte order
+	writer.writeBytes(framebuffer, sizeof(framebuffer));
+	writer.endChunk();
+}
+
+bool GPU::loadFrame(StateReader& reader)
+{
+	if (!reader.openChunk("FRAM"))
+	{
+		return false;
+	}
+
+	reader.readBytes(framebuffer, sizeof(framebuffer));
+	memset(dirtyRows, 1, sizeof(dirtyRows));
+	return reader.ok();
+}
+
+bool GPU::isEnabled()
+{
+	return reg(LCDC) & 0x80;
+}
+
+void GPU::setMode(enum mode newMode)
+{
+	gpuMode = newMode;
+	reg(STAT) = (reg(STAT) & ~0x03) | newMode;
+
+	// STAT bits 3-5 request an interrupt on entering hblank, vblank & oam
+	if (newMode != VRAM && (reg(STAT) & (0x08 << newMode)))
+	{
+		interrupts->request(INT_STAT);
+	}
+}
+
+void GPU::setLine(int line)
+{
+	currLine = line;
+	reg(LY) = line;
+
+	if (line == reg(LYC))
+	{
+		reg(STAT) |= 0x04;
+		if (reg(STAT) & 0x40)
+		{
+			interrupts->request(INT_STAT);
+		}
+	} else
+	{
+		reg(STAT) &= ~0x04;
+	}
+}
+
+int GPU::cyclesUntilEvent()
+{
+	if (!isEnabled()) {
+		return -1;
+	}
+
+	switch(gpuMode) {
+		case OAM: return OAM_CYCLES - scanningCounter;
+		case VRAM: return VRAM_CYCLES - scanningCounter;
+		case HBLANK: return HBLANK_CYCLES - scanningCounter;
+		default: return LINE_CYCLES - scanningCounter;
+	}
+}
+
+int GPU::cyclesUntilVBlank()
+{
+	if (!isEnabled()) {
+		return -1;
+	}
+
+	int intoLine = scanningCounter;
+	switch(gpuMode) {
+		case HBLANK: intoLine += VRAM_CYCLES;
+		// fall through
+		case VRAM: intoLine += OAM_CYCLES;
+		// fall through
+		default: break;
+	}
+
+	int lines = SCREEN_HEIGHT - currLine;
+	if (gpuMode == VBLANK) {
+		lines += LAST_LINE + 1;
+	}
+	return lines * LINE_CYCLES - intoLine;
+}
+
+/*
+ * Each line is OAM search -> VRAM transfer -> HBLANK, followed by 10 lines
+ * of VBLANK once the last visible line is done.
+ */
 void GPU::step(int cycles)
 {
-	// if (!isEnabled()) {
-	// 	return;
-	// }
+	if (!isEnabled()) {
+		// lcd off holds the gpu at the start of line 0's OAM search, so
+		// turning it on draws line 0 first. STAT reads mode 0 until then
+		scanningCounter = 0;
+		windowLine = 0;
+		currLine = 0;
+		reg(LY) = 0;
+		gpuMode = OAM;
+		reg(STAT) &= ~0x03;
+		return;
+	}
+
+	scanningCounter += cycles;
+
+	while (true)
+	{
+		switch(gpuMode) {
+			case OAM:
+				if (scanningCounter < OAM_CYCLES) {
+					return;
+				}
+				scanningCounter -= OAM_CYCLES;
+				setMode(VRAM);
+				break;
+			case VRAM:
+				if (scanningCounter < VRAM_CYCLES) {
+					return;
+				}
+				scanningCounter -= VRAM_CYCLES;
+				renderScanline();
+				setMode(HBLANK);
+				break;
+			case HBLANK:
+				if (scanningCounter < HBLANK_CYCLES) {
+					return;
+				}
+				scanningCounter -= HBLANK_CYCLES;
+				setLine(currLine + 1);
+
+				// reached last line, enter vblank
+				if (currLine == SCREEN_HEIGHT) {
+					setMode(VBLANK);
+					interrupts->request(INT_VBLANK);
+				} else {
+					setMode(OAM);
+				}
+				break;
+			case VBLANK:
+				if (scanningCounter < LINE_CYCLES) {
+					return;
+				}
+				scanningCounter -= LINE_CYCLES;
+
+				if (currLine == LAST_LINE) {
+					windowLine = 0;
+					setLine(0);
+					setMode(OAM);
+				} else {
+					setLine(currLine + 1);
+				}
+				break;
+		}
+	}
+}
+
+/*
+ * Bring the tile cache up to date with any tiles written since last time
+ */
+void GPU::decodeTiles()
+{
+	for (int tile = 0; tile < 384; tile++)
+	{
+		if (!dirtyTiles[tile])
+		{
+			continue;
+		}
+
+		decodeTile(vram + tile * 16, tiles[tile][0]);
+		dirtyTiles[tile] = false;
+	}
+	*tilesDirty = false;
+}
+
+/*
+ * Fill line from screen x from onwards with map row mapY of the tile map at
+ * vram offset tileMap, starting mapX pixels into the row. Whole tiles are
+ * written, so line needs 8 bytes of slack on either side.
+ */
+void GPU::renderTiles(BYTE* line, int tileMap, int mapY, int mapX, int from)
+{
+	bool unsignedTiles = reg(LCDC) & 0x10;
+	const BYTE* mapRow = vram + tileMap + (mapY >> 3) * 32;
+	int fineY = mapY & 7;
+	int tileX = (mapX >> 3) & 31;
 
-	// scanningCounter += cycles;
+	for (int x = from - (mapX & 7); x < SCREEN_WIDTH; x += 8)
+	{
+		BYTE tile = mapRow[tileX];
+		int index = unsignedTiles ? tile : 256 + (SIGNED_BYTE) tile;
 
-	// switch(mode) {
-	// 	case HBLANK:
-	// 		if (scanningCounter >= 204) {
-	// 			currLine++;
-	// 			scanningCounter = 0;
+		memcpy(line + x, tiles[index][fineY], 8);
+		tileX = (tileX + 1) & 31;
+	}
+}
+
+/*
+ * Sprite pixels for this line: colour index in bits 0-1, palette in bit 2,
+ * bit 3 set when the sprite sits behind background colours 1-3.
+ */
+void GPU::renderSprites(BYTE* line)
+{
+	int height = (reg(LCDC) & 0x04) ? 16 : 8;
+
+	// the first 10 sprites in OAM that cover this line
+	int selected[10];
+	int count = 0;
+	for (int i = 0; i < 40 && count < 10; i++)
+	{
+		int y = oam[i * 4] - 16;
+		if (y <= currLine && currLine < y + height)
+		{
+			selected[count++] = i;
+		}
+	}
+
+	// draw lowest priority first: larger x, then later in OAM
+	for (int i = 1; i < count; i++)
+	{
+		int sprite = selected[i];
+		int j = i;
+		while (j > 0 && (oam[selected[j - 1] * 4 + 1] < oam[sprite * 4 + 1] ||
+			(oam[selected[j - 1] * 4 + 1] == oam[sprite * 4 + 1] && selected[j - 1] < sprite)))
+		{
+			selected[j] = selected[j - 1];
+			j--;
+		}
+		selected[j] = sprite;
+	}
 
-	// 			// reached last line, enter vblank
-	// 			if (line == 143) {
-	// 				mode = VBLANK;
-	// 			} else {
-	// 				mode = OAM;
-	// 			}
-	// 		}
-	// 		break;
-	// 	case VBLANK:
+	for (int i = 0; i < count; i++)
+	{
+		const BYTE* attributes = oam + selected[i] * 4;
+		int x = attributes[1] - 8;
+		BYTE tile = attributes[2];
+		BYTE flags = attributes[3];
 
-	// 	case OAM:
+		int row = currLine - (attributes[0] - 16);
+		if (flags & 0x40) {
+			row = height - 1 - row;
+		}
+		if (height == 16) {
+			tile &= 0xfe;
+		}
 
-	// 	case VRAM:
+		const BYTE* pixels = tiles[tile + (row >> 3)][row & 7];
+
+		BYTE attribute = ((flags & 0x10) ? 0x04 : 0) | ((flags & 0x80) ? 0x08 : 0);
+		for (int p = 0; p < 8; p++)
+		{
+			// sprites can sit partly or wholly off either edge of the screen
+			if (x + p < 0 || x + p >= SCREEN_WIDTH) {
+				continue;
+			}
+			BYTE colour = pixels[(flags & 0x20) ? 7 - p : p];
+			if (colour) {
+				line[x + p] = colour | attribute;
+			}
+		}
+	}
+}
+
+void GPU::renderScanline()
+{
+	BYTE lcdc = reg(LCDC);
 
-	// }
-}
\ No newline at end of file
+	if (*tilesDirty)
+	{
+		decodeTiles();
+	}
+
+	// colour indices for the line, with 8 pixels of slack on each side
+	BYTE background[SCREEN_WIDTH + 16];
+	BYTE sprites[SCREEN_WIDTH + 16];
+	memset(background, 0, sizeof(background));
+	memset(sprites, 0, sizeof(sprites));
+
+	if (lcdc & 0x01)
+	{
+		int tileMap = (lcdc & 0x08) ? 0x1c00 : 0x1800;
+		renderTiles(background + 8, tileMap, (currLine + reg(SCY)) & 0xff, reg(SCX), 0);
+
+		int windowX = reg(WX) - 7;
+		if ((lcdc & 0x20) && currLine >= reg(WY) && windowX < SCREEN_WIDTH)
+		{
+			tileMap = (lcdc & 0x40) ? 0x1c00 : 0x1800;
+			if (windowX < 0) {
+				renderTiles(background + 8, tileMap, windowLine, -windowX, 0);
+			} else {
+				renderTiles(background + 8, tileMap, windowLine, 0, windowX);
+			}
+			windowLine++;
+		}
+	}
+
+	if (lcdc & 0x02)
+	{
+		renderSprites(sprites + 8);
+	}
+
+	// background palette in 0-3, OBP0 in 4-7 & OBP1 in 8-11
+	PIXEL colours[12];
+	for (int i = 0; i < 4; i++)
+	{
+		colours[i] = shades[(reg(BGP) >> (i * 2)) & 0x03];
+		colours[i + 4] = shades[(reg(OBP0) >> (i * 2)) & 0x03];
+		colours[i + 8] = shades[(reg(OBP1) >> (i * 2)) & 0x03];
+	}
+
+	// most lines come out the same as last frame, only changed rows need
+	// to be uploaded by the frontend
+	PIXEL line[SCREEN_WIDTH];
+	composeScanline(background + 8, sprites + 8, colours, line, SCREEN_WIDTH);
+
+	PIXEL* row = framebuffer + currLine * SCREEN_WIDTH;
+	if (memcmp(row, line, sizeof(line)) != 0)
+	{
+		memcpy(row, line, sizeof(line));
+		dirtyRows[currLine] = true;
+	}
+}
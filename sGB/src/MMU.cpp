@@ -1,45 +1,274 @@
 #include "MMU.hpp"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
 using namespace std;
 
+const char* const memoryRegionNames[REGION_COUNT] = {
+	"rom0", "romx", "vram", "xram", "wram", "echo", "oam", "io", "hram"
+};
+
+// mapped into the cartridge area until a game is loaded
+static const BYTE blankROM[0x8000] = {};
+
 MMU::MMU():
+mbc(MBC_NONE),
 currROMBank(1),
 currRAMBank(0),
-dividerCounter(0)
+ramEnabled(false),
+bankHigh(0),
+ramBankingMode(false),
+romSwitches(0)
 {
+	romBanks[0] = 0;
+	romBanks[1] = 1;
+	memset(rtc, 0, sizeof(rtc));
+#ifdef SGB_PERF_COUNTERS
+	memset(regionReads, 0, sizeof(regionReads));
+	memset(regionWrites, 0, sizeof(regionWrites));
+#endif
+
+	mapRead(0x00, 0x100, NULL);
+	mapWrite(0x00, 0x100, NULL);
+
+	// cartridge is read only, writes go to the slow path for bank control
+	mapROMBanks();
+	// external RAM stays unmapped until a cartridge enables it
+	mapRAMBank();
+
+	// tile data writes go through the slow path to flag decoded tiles
+	mapRead(0x80, 0x20, vram);
+	mapWrite(0x98, 0x08, vram + 0x1800);
+	markTilesDirty();
+	mapRead(0xc0, 0x20, wram);
+	mapWrite(0xc0, 0x20, wram);
+
+	// echo of internal RAM, E000-FDFF mirrors C000-DDFF
+	mapRead(0xe0, 0x1e, wram);
+	mapWrite(0xe0, 0x1e, wram);
 }
 
 /*
- * Read an 8-bit section from memory
+ * Point count pages starting at page first into consecutive 256 byte
+ * pages of base
 */
-BYTE MMU::readByte(WORD address)
+void MMU::mapRead(int first, int count, const BYTE* base)
 {
-	if (address < 0x8000)
+	for (int i = 0; i < count; i++)
+	{
+		readPages[first + i] = (base != NULL) ? base + (i << 8) : NULL;
+	}
+}
+
+void MMU::mapWrite(int first, int count, BYTE* base)
+{
+	for (int i = 0; i < count; i++)
+	{
+		writePages[first + i] = (base != NULL) ? base + (i << 8) : NULL;
+	}
+}
+
+void MMU::markTilesDirty()
+{
+	for (int i = 0; i < 384; i++)
+	{
+		dirtyTiles[i] = true;
+	}
+	tilesDirty = true;
+}
+
+void MMU::copyRAM(vector<BYTE>& out)
+{
+	out.assign(vram, vram + sizeof(vram));
+	out.insert(out.end(), xram.begin(), xram.end());
+	out.insert(out.end(), wram, wram + sizeof(wram));
+}
+
+void MMU::restoreRAM(const vector<BYTE>& in)
+{
+	const BYTE* from = &in[0];
+	memcpy(vram, from, sizeof(vram));
+	from += sizeof(vram);
+	copy(from, from + xram.size(), xram.begin());
+	from += xram.size();
+	memcpy(wram, from, sizeof(wram));
+}
+
+/*
+ * Bank switching only repoints the ROM pages into the image, nothing is
+ * copied
+*/
+void MMU::mapROMBanks()
+{
+	const BYTE* image = cartridge ? cartridge->data() : blankROM;
+	int banks = (cartridge ? cartridge->size() : sizeof(blankROM)) / 0x4000;
+	int bank0 = 0;
+
+	// MBC1 in RAM banking mode also applies the upper bits to bank 0
+	if (mbc == MBC1 && ramBankingMode)
+	{
+		bank0 = (bankHigh << 5) % banks;
+	}
+
+	int bank1 = currROMBank % banks;
+	if (bank0 != romBanks[0] || bank1 != romBanks[1])
+	{
+		romBanks[0] = bank0;
+		romBanks[1] = bank1;
+		romSwitches++;
+	}
+
+	mapRead(0x00, 0x40, image + bank0 * 0x4000);
+	mapRead(0x40, 0x40, image + bank1 * 0x4000);
+}
+
+// repoints 4000-7FFF only, for switches that leave bank 0 where it is
+void MMU::mapSwitchableBank()
+{
+	const BYTE* image = cartridge ? cartridge->data() : blankROM;
+	int banks = (cartridge ? cartridge->size() : sizeof(blankROM)) / 0x4000;
+	int bank1 = currROMBank % banks;
+	if (bank1 == romBanks[1])
+	{
+		return;
+	}
+
+	romBanks[1] = bank1;
+	romSwitches++;
+	mapRead(0x40, 0x40, image + bank1 * 0x4000);
+}
+
+void MMU::mapRAMBank()
+{
+	// disabled RAM & the MBC3 clock registers are handled by the slow path
+	if (!ramEnabled || xram.empty() || (mbc == MBC3 && currRAMBank >= 0x08))
+	{
+		mapRead(0xa0, 0x20, NULL);
+		mapWrite(0xa0, 0x20, NULL);
+		return;
+	}
+
+	int banks = (xram.size() + 0x1fff) / 0x2000;
+	BYTE* bank = &xram[(currRAMBank % banks) * 0x2000];
+
+	// 2kB carts only fill part of the bank, leave the rest unmapped
+	int pages = xram.size() < 0x2000 ? xram.size() >> 8 : 0x20;
+	mapRead(0xa0, pages, bank);
+	mapWrite(0xa0, pages, bank);
+}
+
+/*
+ * Writes to the ROM area program the memory bank controller
+*/
+void MMU::writeBankControl(WORD address, BYTE data)
+{
+	WORD oldROMBank = currROMBank;
+	BYTE oldRAMBank = currRAMBank;
+	bool oldRAMEnabled = ramEnabled;
+	BYTE oldBankHigh = bankHigh;
+	bool oldBankingMode = ramBankingMode;
+
+	switch(mbc)
 	{
-		return cartridge[address];
+		case MBC_NONE:
+			return;
+		case MBC1:
+			if (address < 0x2000)
+			{
+				ramEnabled = (data & 0x0f) == 0x0a;
+			}
+			else if (address < 0x4000)
+			{
+				// lower 5 bits, bank 0 can't be selected here
+				BYTE low = data & 0x1f;
+				currROMBank = (bankHigh << 5) | (low ? low : 1);
+			}
+			else if (address < 0x6000)
+			{
+				bankHigh = data & 0x03;
+				currROMBank = (bankHigh << 5) | (currROMBank & 0x1f);
+			}
+			else
+			{
+				ramBankingMode = data & 0x01;
+			}
+			currRAMBank = ramBankingMode ? bankHigh : 0;
+			break;
+		case MBC3:
+			if (address < 0x2000)
+			{
+				ramEnabled = (data & 0x0f) == 0x0a;
+			}
+			else if (address < 0x4000)
+			{
+				BYTE bank = data & 0x7f;
+				currROMBank = bank ? bank : 1;
+			}
+			else if (address < 0x6000)
+			{
+				// 0x00-0x03 select a RAM bank, 0x08-0x0C a clock register
+				currRAMBank = data & 0x0f;
+			}
+			// 0x6000-0x7FFF latches the clock, registers are kept as written
+			break;
+		case MBC5:
+			if (address < 0x2000)
+			{
+				ramEnabled = (data & 0x0f) == 0x0a;
+			}
+			else if (address < 0x3000)
+			{
+				currROMBank = (currROMBank & 0x100) | data;
+			}
+			else if (address < 0x4000)
+			{
+				currROMBank = ((data & 0x01) << 8) | (currROMBank & 0xff);
+			}
+			else if (address < 0x6000)
+			{
+				currRAMBank = data & 0x0f;
+			}
+			break;
 	}
-	else if (0x8000 <= address && address < 0xa000)
+
+	// most writes re-select the mapped bank or only toggle RAM, so only
+	// repoint the pages whose bank actually moved
+	if (mbc == MBC1 && (bankHigh != oldBankHigh || ramBankingMode != oldBankingMode))
 	{
-		return vram[address - 0x8000];
+		// MBC1 in RAM banking mode can move bank 0 too
+		mapROMBanks();
 	}
-	else if (0xa000 <= address && address < 0xc000)
+	else if (currROMBank != oldROMBank)
 	{
-		return xram[address - 0xa000];
+		mapSwitchableBank();
 	}
-	else if (0xc000 <= address && address < 0xe000)
+
+	if (currRAMBank != oldRAMBank || ramEnabled != oldRAMEnabled)
 	{
-		return wram[address - 0xc000];
+		mapRAMBank();
 	}
-	else if (0xe000 <= address && address < 0xfe00)
+}
+
+/*
+ * Accesses that aren't a plain array index: OAM & the unusable area after
+ * it, I/O ports, internal RAM and the interrupt enable register
+*/
+BYTE MMU::readSlow(WORD address)
+{
+	if (0xa000 <= address && address < 0xc000)
 	{
-		return wram[address - 0xe000];
+		// external RAM is disabled or is showing an MBC3 clock register
+		if (ramEnabled && mbc == MBC3 && 0x08 <= currRAMBank && currRAMBank <= 0x0c)
+		{
+			return rtc[currRAMBank - 0x08];
+		}
+		return 0xff;
 	}
-	else if (0xfe00 <= address && address < 0xff00)
+	else if (address < 0xff00)
 	{
 		// first part is accessible for oam, rest is empty
-		if (address < 0xfea0) 
+		if (0xfe00 <= address && address < 0xfea0) 
 		{
 			return oam[address - 0xfe00];	
 		} else
@@ -47,9 +276,17 @@ BYTE MMU::readByte(WORD address)
 			return 0;
 		}
 	}
-	else if (0xff00 <= address && address < 0xff80)
+	else if (address < 0xff80)
 	{
-		if (address < 0xff4c)
+		if (address == IF)
+		{
+			return interrupts.readIF();
+		}
+		else if (DIV <= address && address <= TMC && timerRead)
+		{
+			return timerRead(address);
+		}
+		else if (address < 0xff4c)
 		{
 			return io[address - 0xff00];
 		} else 
@@ -57,59 +294,50 @@ BYTE MMU::readByte(WORD address)
 			return 0;
 		}
 	} 
-	else if (0xff80 <= address && address < 0xffff)
+	else if (address < 0xffff)
 	{
 		return ram[address - 0xff80];
 	}
 	else 
 	{
-		return 0;
+		return interrupts.readIE();
 	}
 }
 
-/*
- * Read a 16-bit word from memory
-*/
-WORD MMU::readWord(WORD address)
+void MMU::writeSlow(WORD address, BYTE data)
 {
-	return readByte(address) | (readByte(address + 1) << 8);
-}
-
-void MMU::writeByte(WORD address, BYTE data)
-{
-	// First 0x8000 is cartridge memory, and read only...
+	// cartridge memory is read only, writes program the bank controller
 	if (address < 0x8000)
-		return;
-
-	if (address < 0xa000)
 	{
-		vram[address - 0x8000] = data;
+		writeBankControl(address, data);
 		return;
 	}
 
-	if (address < 0xc000)
+	if (address < 0x9800)
 	{
-		xram[address - 0xa000] = data;
+		BYTE& tileData = vram[address - 0x8000];
+		if (tileData != data)
+		{
+			tileData = data;
+			dirtyTiles[(address - 0x8000) >> 4] = true;
+			tilesDirty = true;
+		}
 		return;
 	}
 
-	if (address < 0xe000)
+	if (0xa000 <= address && address < 0xc000)
 	{
-		wram[address - 0xc000] = data;
+		if (ramEnabled && mbc == MBC3 && 0x08 <= currRAMBank && currRAMBank <= 0x0c)
+		{
+			rtc[currRAMBank - 0x08] = data;
+		}
 		return;
 	}
 
-	if (address < 0xfe00)
-	{
-		wram[address - 0xe000] = data;
-		return;
-
-	}
-	
 	if (address < 0xff00)
 	{
 		// first part is accessible for oam, rest is empty
-		if (address < 0xfea0) 
+		if (0xfe00 <= address && address < 0xfea0) 
 		{
 			oam[address - 0xfe00] = data;
 		}
@@ -118,38 +346,72 @@ void MMU::writeByte(WORD address, BYTE data)
 
 	if (address < 0xff80)
 	{
-		if (address < 0xff4c)
+		// let the timer & gpu catch up before their timing changes
+		bool timerRegister = DIV <= address && address <= TMC;
+		if ((timerRegister || address == LCDC) && timingHandler)
+		{
+			timingHandler();
+		}
+
+		if (timerRegister && timerWrite)
+		{
+			timerWrite(address, data);
+		} else if (address == DIV)
+		{
+			// any write resets the divider
+			io[address - 0xff00] = 0;
+		} else if (address == IF)
+		{
+			interrupts.writeIF(data);
+		} else if (address < 0xff4c)
 		{
 			io[address - 0xff00] = data;
 		}
+
+		// copy 0xA0 bytes from data * 0x100 into OAM
+		if (address == DMA)
+		{
+			for (int i = 0; i < 0xa0; i++)
+			{
+				oam[i] = readByte((data << 8) + i);
+			}
+		}
 		return;
 	} 
 	
 	if (address < 0xffff)
 	{
 		ram[address - 0xff80] = data;
+	} else
+	{
+		interrupts.writeIE(data);
 	}
 }
 
-void MMU::writeWord(WORD address, WORD data)
-{
-	this->writeByte(address, data & 0xff);
-	this->writeByte(address + 1, (data >> 8) & 0xff);
-}
-
 void MMU::reset()
 {
 	cout << "Currently reseting all memory..." << endl;
-	dividerCounter = 0;
+
+	// back to the power on banks, the loaded ROM image is kept
+	currROMBank = 1;
+	currRAMBank = 0;
+	// without a bank controller RAM is always accessible
+	ramEnabled = (mbc == MBC_NONE);
+	bankHigh = 0;
+	ramBankingMode = false;
+	memset(rtc, 0, sizeof(rtc));
+	mapROMBanks();
+	mapRAMBank();
 
 	// reset all memory to zero
-	memset(cartridge, 0, sizeof(cartridge));
 	memset(vram, 0, sizeof(vram));
-	memset(xram, 0, sizeof(xram));
+	markTilesDirty();
+	fill(xram.begin(), xram.end(), 0);
 	memset(wram, 0, sizeof(wram));
 	memset(oam, 0, sizeof(oam));
 	memset(io, 0, sizeof(io)); // might have to set some io defaults instead
 	memset(ram, 0, sizeof(ram));
+	interrupts.reset();
 
 	// set some required memory accordingly
 	writeByte(0xFF05, 0x00); 
@@ -187,54 +449,147 @@ void MMU::reset()
 	cout << "Successfully reset all memory!" << endl;
 }
 
-void MMU::loadGame(ifstream& romFile, BYTE romTypeVal)
+void MMU::loadGame(shared_ptr<const ROMImage> rom, BYTE romTypeVal)
 {
 	romType rt = static_cast<romType>(romTypeVal);
 
 	switch(rt) {
 		case ROM_ONLY:
-			romFile.read((char*) cartridge, 0x8000);
+		case ROM_RAM:
+		case ROM_RAM_BATTERY:
+			mbc = MBC_NONE;
 			break;
 		case ROM_MBC1:
 		case ROM_MBC1_RAM:
 		case ROM_MBC1_RAM_BATT:
-		case ROM_MBC2:
-		case ROM_MBC2_BATTERY:
-		case ROM_RAM:
-		case ROM_RAM_BATTERY:
-		case ROM_MMM01:
-		case ROM_MMM01_SRAM:
-		case ROM_MMM01_SRAM_BATT:
+			mbc = MBC1;
+			break;
 		case ROM_MBC3_TIMER_BATT:
 		case ROM_MBC3_TIMER_RAM_BATT:
 		case ROM_MBC3:
 		case ROM_MBC3_RAM:
 		case ROM_MBC3_RAM_BATT:
+			mbc = MBC3;
+			break;
 		case ROM_MBC5:
 		case ROM_MBC5_RAM:		
 		case ROM_MBC5_RAM_BATT:
 		case ROM_MBC5_RUMBLE:
 		case ROM_MBC5_RUMBLE_SRAM:
 		case ROM_MBC5_RUMBLE_SRAM_BATT:
+			mbc = MBC5;
+			break;
+		case ROM_MBC2:
+		case ROM_MBC2_BATTERY:
+		case ROM_MMM01:
+		case ROM_MMM01_SRAM:
+		case ROM_MMM01_SRAM_BATT:
 		case ROM_POCKET_CAMERA:
 		case ROM_BANDAI_TAMA5:
 		case ROM_HUDSON_HUC3:
 		case ROM_HUDSON_HUC1:
+			cout << "Bank controller not supported, running as ROM only." << endl;
+			mbc = MBC_NONE;
 			break;
 	}
+
+	cartridge = rom;
+	xram.assign(ramSize(cartridge->data()[RAM_SIZE_ADDRESS]), 0);
+
+	reset();
 }
 
-BYTE MMU::getTimerFreq()
+/*
+ * External RAM size in bytes for the header value at RAM_SIZE_ADDRESS
+*/
+size_t MMU::ramSize(BYTE ramSizeVal)
 {
-	return readByte(TMC) & 0x03;
+	switch(ramSizeVal)
+	{
+		case 0x01: return 0x800;
+		case 0x02: return 0x2000;
+		case 0x03: return 0x8000;
+		case 0x04: return 0x20000;
+		case 0x05: return 0x10000;
+		default: return 0;
+	}
 }
 
-void MMU::dividerRegisters(int cycles)
+void MMU::saveState(StateWriter& writer)
 {
-	dividerCounter += cycles;
-	if (dividerCounter >= 255)
+	writer.beginChunk("MMU ");
+	writer.write8(mbc);
+	writer.write16(currROMBank);
+	writer.write8(currRAMBank);
+	writer.write8(ramEnabled);
+	writer.write8(bankHigh);
+	writer.write8(ramBankingMode);
+	writer.writeBytes(rtc, sizeof(rtc));
+
+	writer.write32(xram.size());
+	if (!xram.empty())
 	{
-		dividerCounter = 0;
-		
+		writer.writeBytes(&xram[0], xram.size());
 	}
-}
\ No newline at end of file
+	writer.writeBytes(vram, sizeof(vram));
+	writer.writeBytes(wram, sizeof(wram));
+	writer.writeBytes(oam, sizeof(oam));
+	// IF & IE come from interrupts, written where they'd sit in memory.
+	// IME is saved with the cpu
+	int ifOffset = IF - 0xff00;
+	writer.writeBytes(io, ifOffset);
+	writer.write8(interrupts.readIF());
+	writer.writeBytes(io + ifOffset + 1, sizeof(io) - ifOffset - 1);
+	writer.writeBytes(ram, IE - 0xff80);
+	writer.write8(interrupts.readIE());
+	writer.endChunk();
+}
+
+bool MMU::loadState(StateReader& reader)
+{
+	if (!reader.openChunk("MMU "))
+	{
+		return false;
+	}
+
+	BYTE savedMBC = reader.read8();
+	WORD romBank = reader.read16();
+	BYTE ramBank = reader.read8();
+	bool enabled = reader.read8();
+	BYTE high = reader.read8();
+	bool bankingMode = reader.read8();
+	BYTE clock[sizeof(rtc)];
+	reader.readBytes(clock, sizeof(clock));
+	size_t ramLength = reader.read32();
+
+	size_t memoryLength = ramLength + sizeof(vram) + sizeof(wram) + sizeof(oam) + sizeof(io) + sizeof(ram);
+	if (!reader.ok() || savedMBC != mbc || ramLength != xram.size() || reader.remaining() != memoryLength)
+	{
+		cout << "Error: save state doesn't match the cartridge" << endl;
+		return false;
+	}
+
+	currROMBank = romBank;
+	currRAMBank = ramBank;
+	ramEnabled = enabled;
+	bankHigh = high;
+	ramBankingMode = bankingMode;
+	memcpy(rtc, clock, sizeof(rtc));
+
+	if (!xram.empty())
+	{
+		reader.readBytes(&xram[0], xram.size());
+	}
+	reader.readBytes(vram, sizeof(vram));
+	reader.readBytes(wram, sizeof(wram));
+	reader.readBytes(oam, sizeof(oam));
+	reader.readBytes(io, sizeof(io));
+	reader.readBytes(ram, sizeof(ram));
+	interrupts.writeIF(io[IF - 0xff00]);
+	interrupts.writeIE(ram[IE - 0xff80]);
+
+	mapROMBanks();
+	mapRAMBank();
+	markTilesDirty();
+	return reader.ok();
+}
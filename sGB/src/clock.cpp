@@ -2,21 +2,12 @@
 
 using namespace std;
 
-Clock::Clock() :
-machineCycles(0),
-clockCycles(0)
+void Clock::saveState(StateWriter& writer)
 {
-
+	writer.write64(cycles);
 }
 
-void Clock::updateClocks(int cycles)
+void Clock::loadState(StateReader& reader)
 {
-	clockCycles += cycles;
-	machineCycles += (cycles/4);
+	cycles = reader.read64();
 }
-
-void Clock::resetClocks()
-{
-	clockCycles = 0;
-	machineCycles = 0;
-}
\ No newline at end of file
@@ -0,0 +1,291 @@
+#include "emitter.hpp"
+
+// no index register in a memory operand
+static const int NO_INDEX = -1;
+
+void Emitter::dword(uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		byte((value >> (i * 8)) & 0xff);
+	}
+}
+
+/*
+ * REX is only written when something needs it: a 64 bit operand, r8-r15
+ * anywhere or the low byte of rsp-rdi.
+ */
+void Emitter::rex(bool wide, int reg, int index, int base, bool byteRegs)
+{
+	if (index < 0) {
+		index = 0;
+	}
+
+	BYTE prefix = 0x40 | (wide ? 0x08 : 0) | ((reg & 8) ? 0x04 : 0) |
+		((index & 8) ? 0x02 : 0) | ((base & 8) ? 0x01 : 0);
+	if (prefix != 0x40 || byteRegs)
+	{
+		byte(prefix);
+	}
+}
+
+void Emitter::registerOperand(int reg, int rm)
+{
+	byte(0xc0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+/*
+ * [base + disp] or [base + index * scale + disp]. rsp & r12 as a base need
+ * a SIB byte, rbp & r13 can't go without a displacement.
+ */
+void Emitter::memoryOperand(int reg, int base, int index, int scale, int disp)
+{
+	int mod = 2;
+	if (disp == 0 && (base & 7) != RBP) {
+		mod = 0;
+	} else if (disp >= -128 && disp <= 127) {
+		mod = 1;
+	}
+
+	if (index == NO_INDEX && (base & 7) != RSP)
+	{
+		byte((mod << 6) | ((reg & 7) << 3) | (base & 7));
+	} else
+	{
+		int scaleBits = scale == 8 ? 3 : scale == 4 ? 2 : scale == 2 ? 1 : 0;
+		if (index == NO_INDEX) {
+			index = RSP; // no index
+		}
+		byte((mod << 6) | ((reg & 7) << 3) | RSP);
+		byte((scaleBits << 6) | ((index & 7) << 3) | (base & 7));
+	}
+
+	if (mod == 1) {
+		byte((BYTE) disp);
+	} else if (mod == 2) {
+		dword(disp);
+	}
+}
+
+void Emitter::mov(hostReg dst, hostReg src)
+{
+	rex(false, src, NO_INDEX, dst, false);
+	byte(0x89);
+	registerOperand(src, dst);
+}
+
+void Emitter::mov64(hostReg dst, hostReg src)
+{
+	rex(true, src, NO_INDEX, dst, false);
+	byte(0x89);
+	registerOperand(src, dst);
+}
+
+void Emitter::movImm(hostReg dst, uint32_t imm)
+{
+	rex(false, 0, NO_INDEX, dst, false);
+	byte(0xb8 + (dst & 7));
+	dword(imm);
+}
+
+void Emitter::movzx8(hostReg dst, hostReg src)
+{
+	rex(false, dst, NO_INDEX, src, src >= RSP);
+	byte(0x0f);
+	byte(0xb6);
+	registerOperand(dst, src);
+}
+
+void Emitter::alu(aluOp op, hostReg dst, hostReg src)
+{
+	rex(false, src, NO_INDEX, dst, false);
+	byte((op << 3) | 0x01);
+	registerOperand(src, dst);
+}
+
+void Emitter::aluImm(aluOp op, hostReg dst, int32_t imm)
+{
+	rex(false, 0, NO_INDEX, dst, false);
+	if (imm >= -128 && imm <= 127)
+	{
+		byte(0x83);
+		registerOperand(op, dst);
+		byte((BYTE) imm);
+	} else
+	{
+		byte(0x81);
+		registerOperand(op, dst);
+		dword(imm);
+	}
+}
+
+void Emitter::shiftImm(shiftOp op, hostReg dst, BYTE count)
+{
+	rex(false, 0, NO_INDEX, dst, false);
+	byte(0xc1);
+	registerOperand(op, dst);
+	byte(count);
+}
+
+void Emitter::test64(hostReg a, hostReg b)
+{
+	rex(true, b, NO_INDEX, a, false);
+	byte(0x85);
+	registerOperand(b, a);
+}
+
+void Emitter::load64Indexed(hostReg dst, hostReg base, hostReg index)
+{
+	rex(true, dst, index, base, false);
+	byte(0x8b);
+	memoryOperand(dst, base, index, 8, 0);
+}
+
+void Emitter::load8Indexed(hostReg dst, hostReg base, hostReg index)
+{
+	rex(false, dst, index, base, false);
+	byte(0x0f);
+	byte(0xb6);
+	memoryOperand(dst, base, index, 1, 0);
+}
+
+void Emitter::store8Indexed(hostReg base, hostReg index, hostReg src)
+{
+	rex(false, src, index, base, src >= RSP);
+	byte(0x88);
+	memoryOperand(src, base, index, 1, 0);
+}
+
+void Emitter::load8(hostReg dst, hostReg base, int disp)
+{
+	rex(false, dst, NO_INDEX, base, false);
+	byte(0x0f);
+	byte(0xb6);
+	memoryOperand(dst, base, NO_INDEX, 1, disp);
+}
+
+void Emitter::load16(hostReg dst, hostReg base, int disp)
+{
+	rex(false, dst, NO_INDEX, base, false);
+	byte(0x0f);
+	byte(0xb7);
+	memoryOperand(dst, base, NO_INDEX, 1, disp);
+}
+
+void Emitter::load32(hostReg dst, hostReg base, int disp)
+{
+	rex(false, dst, NO_INDEX, base, false);
+	byte(0x8b);
+	memoryOperand(dst, base, NO_INDEX, 1, disp);
+}
+
+void Emitter::store8(hostReg base, int disp, hostReg src)
+{
+	rex(false, src, NO_INDEX, base, src >= RSP);
+	byte(0x88);
+	memoryOperand(src, base, NO_INDEX, 1, disp);
+}
+
+void Emitter::store16(hostReg base, int disp, hostReg src)
+{
+	byte(0x66);
+	rex(false, src, NO_INDEX, base, false);
+	byte(0x89);
+	memoryOperand(src, base, NO_INDEX, 1, disp);
+}
+
+void Emitter::store32(hostReg base, int disp, hostReg src)
+{
+	rex(false, src, NO_INDEX, base, false);
+	byte(0x89);
+	memoryOperand(src, base, NO_INDEX, 1, disp);
+}
+
+void Emitter::store8Imm(hostReg base, int disp, BYTE imm)
+{
+	rex(false, 0, NO_INDEX, base, false);
+	byte(0xc6);
+	memoryOperand(0, base, NO_INDEX, 1, disp);
+	byte(imm);
+}
+
+void Emitter::store16Imm(hostReg base, int disp, WORD imm)
+{
+	byte(0x66);
+	rex(false, 0, NO_INDEX, base, false);
+	byte(0xc7);
+	memoryOperand(0, base, NO_INDEX, 1, disp);
+	byte(imm & 0xff);
+	byte(imm >> 8);
+}
+
+void Emitter::store32Imm(hostReg base, int disp, uint32_t imm)
+{
+	rex(false, 0, NO_INDEX, base, false);
+	byte(0xc7);
+	memoryOperand(0, base, NO_INDEX, 1, disp);
+	dword(imm);
+}
+
+void Emitter::cmp8Imm(hostReg base, int disp, BYTE imm)
+{
+	rex(false, 0, NO_INDEX, base, false);
+	byte(0x80);
+	memoryOperand(ALU_CMP, base, NO_INDEX, 1, disp);
+	byte(imm);
+}
+
+void Emitter::test32Imm(hostReg base, int disp, uint32_t imm)
+{
+	rex(false, 0, NO_INDEX, base, false);
+	byte(0xf7);
+	memoryOperand(0, base, NO_INDEX, 1, disp);
+	dword(imm);
+}
+
+int Emitter::jcc(condition cond)
+{
+	byte(0x0f);
+	byte(0x80 | cond);
+	dword(0);
+	return size() - 4;
+}
+
+int Emitter::jmp()
+{
+	byte(0xe9);
+	dword(0);
+	return size() - 4;
+}
+
+void Emitter::bind(int jump)
+{
+	bindTo(jump, size());
+}
+
+// displacements count from the end of the jump
+void Emitter::bindTo(int jump, int target)
+{
+	uint32_t displacement = target - (jump + 4);
+	for (int i = 0; i < 4; i++)
+	{
+		buffer[jump + i] = (displacement >> (i * 8)) & 0xff;
+	}
+}
+
+void Emitter::push(hostReg reg)
+{
+	rex(false, 0, NO_INDEX, reg, false);
+	byte(0x50 + (reg & 7));
+}
+
+void Emitter::pop(hostReg reg)
+{
+	rex(false, 0, NO_INDEX, reg, false);
+	byte(0x58 + (reg & 7));
+}
+
+void Emitter::ret()
+{
+	byte(0xc3);
+}
@@ -0,0 +1,200 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include "constants.hpp"
+#include "sGBEmulator.hpp"
+
+using namespace std;
+
+static void writePerfLine(FILE* out, const perfCounters& perf)
+{
+	fprintf(out, "{\"frame\":%llu,\"update_ns\":%llu,\"cpu_ns\":%llu,\"timer_ns\":%llu,"
+		"\"gpu_ns\":%llu,\"interrupt_ns\":%llu,\"instructions\":%llu,\"rom_bank_switches\":%llu",
+		(unsigned long long) perf.frame, (unsigned long long) perf.updateTime,
+		(unsigned long long) perf.cpuTime, (unsigned long long) perf.timerTime,
+		(unsigned long long) perf.gpuTime, (unsigned long long) perf.interruptTime,
+		(unsigned long long) perf.instructions, (unsigned long long) perf.romBankSwitches);
+
+	const uint64_t* counts[2] = { perf.reads, perf.writes };
+	const char* names[2] = { "reads", "writes" };
+	for (int i = 0; i < 2; i++)
+	{
+		fprintf(out, ",\"%s\":{", names[i]);
+		for (int region = 0; region < REGION_COUNT; region++)
+		{
+			fprintf(out, "%s\"%s\":%llu", region ? "," : "", memoryRegionNames[region],
+				(unsigned long long) counts[i][region]);
+		}
+		fprintf(out, "}");
+	}
+	fprintf(out, "}\n");
+}
+
+/*
+ * Runs the emulator without a window or vsync, as fast as the host allows,
+ * for a fixed number of frames or cycles, optionally starting from and/or
+ * ending with a save state.
+ *
+ * usage: sGB_headless <rom path> [--frames N | --cycles N] [--jit | --jit-verify]
+ *                     [--load-state FILE] [--save-state FILE] [--rewind SECONDS]
+ *                     [--profile PATH] [--perf PATH] [--step]
+ *
+ * --perf writes the host cost of every frame as JSON lines, - for stdout.
+ * --step syncs everything after every instruction, see setStepping.
+ */
+int main (int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		cout << "Usage: " << argv[0] << " <rom path> [--frames N | --cycles N] [--jit | --jit-verify] [--load-state FILE] [--save-state FILE] [--rewind SECONDS] [--profile PATH] [--perf PATH] [--step]" << endl;
+		return 1;
+	}
+
+	string romPath = argv[1];
+	long long frames = 60 * REFRESHRATE;
+	CPU::jitMode jit = CPU::JIT_OFF;
+	string loadPath;
+	string savePath;
+	long long rewindFrames = 0;
+	string profilePath;
+	FILE* perfFile = NULL;
+	bool stepping = false;
+
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+		{
+			frames = stoll(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--cycles") == 0 && i + 1 < argc)
+		{
+			// update() runs a whole frame at a time
+			frames = (stoll(argv[++i]) + MAXCYCLES - 1) / MAXCYCLES;
+		}
+		else if (strcmp(argv[i], "--step") == 0)
+		{
+			stepping = true;
+		}
+		else if (strcmp(argv[i], "--jit") == 0)
+		{
+			jit = CPU::JIT_ON;
+		}
+		else if (strcmp(argv[i], "--jit-verify") == 0)
+		{
+			// every compiled block is checked against the interpreter
+			jit = CPU::JIT_VERIFY;
+		}
+		else if (strcmp(argv[i], "--load-state") == 0 && i + 1 < argc)
+		{
+			loadPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--save-state") == 0 && i + 1 < argc)
+		{
+			savePath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--rewind") == 0 && i + 1 < argc)
+		{
+			// records history as it runs, to measure what that costs
+			rewindFrames = stoll(argv[++i]) * REFRESHRATE;
+		}
+		else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc)
+		{
+#ifdef SGB_PROFILE
+			profilePath = argv[++i];
+#else
+			cout << "Error: built without SGB_PROFILE" << endl;
+			return 1;
+#endif
+		}
+		else if (strcmp(argv[i], "--perf") == 0 && i + 1 < argc)
+		{
+#ifdef SGB_PERF_COUNTERS
+			const char* path = argv[++i];
+			perfFile = strcmp(path, "-") == 0 ? stdout : fopen(path, "w");
+			if (perfFile == NULL)
+			{
+				cout << "Error opening: " << path << endl;
+				return 1;
+			}
+#else
+			cout << "Error: built without SGB_PERF_COUNTERS" << endl;
+			return 1;
+#endif
+		}
+		else
+		{
+			cout << "Error: unknown option " << argv[i] << endl;
+			return 1;
+		}
+	}
+
+	sGBEmulator sGB(romPath);
+	if (!sGB.setJITMode(jit))
+	{
+		return 1;
+	}
+	if (!loadPath.empty() && !sGB.loadState(loadPath))
+	{
+		return 1;
+	}
+	sGB.setRewindLength(rewindFrames);
+	sGB.setStepping(stepping);
+
+	long long frame = 0;
+	bool success = true;
+
+	auto start = chrono::steady_clock::now();
+	while (frame < frames && success)
+	{
+		success = sGB.update();
+		frame++;
+		if (perfFile != NULL)
+		{
+			writePerfLine(perfFile, sGB.getPerfCounters());
+		}
+	}
+	chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+	if (perfFile != NULL && perfFile != stdout)
+	{
+		fclose(perfFile);
+	}
+
+	if (!savePath.empty() && !sGB.saveState(savePath))
+	{
+		return 1;
+	}
+#ifdef SGB_PROFILE
+	if (!profilePath.empty() && !sGB.writeProfile(profilePath))
+	{
+		return 1;
+	}
+#endif
+
+	double emulated = (double) frame * MAXCYCLES / CLOCKSPEED;
+	printf("frames: %lld\n", frame);
+	printf("cycles: %lld\n", frame * MAXCYCLES);
+	printf("time: %.3f s\n", elapsed.count());
+	printf("fps: %.1f\n", frame / elapsed.count());
+	printf("speed: %.2fx\n", emulated / elapsed.count());
+	if (rewindFrames > 0)
+	{
+		printf("rewind: %zu frames in %zu bytes\n", sGB.rewindFrames(), sGB.rewindMemory());
+	}
+	if (jit == CPU::JIT_VERIFY)
+	{
+		printf("jit mismatches: %u\n", sGB.getJITMismatches());
+	}
+
+	if (jit == CPU::JIT_VERIFY && sGB.getJITMismatches() > 0)
+	{
+		return 1;
+	}
+	if (!success)
+	{
+		cout << "Emulation stopped early at frame " << frame << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,798 @@
+#include "jit.hpp"
+
+#ifdef SGB_JIT
+
+#include <cstring>
+#include <vector>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "emitter.hpp"
+
+using namespace std;
+
+// code space for every compiled block of a game
+static const size_t ARENA_SIZE = 4 << 20;
+
+/*
+ * Host registers. The first four hold the arguments, the SM83 registers
+ * live in the next five & the rest are scratch. Pairs are kept as 16 bit
+ * values, A on its own. Nothing is called from native code, so only the
+ * callee saved registers need keeping.
+ */
+static const hostReg REGS = RDI;
+static const hostReg FLAGS = RSI;
+static const hostReg READ_PAGES = RDX;
+static const hostReg WRITE_PAGES = RCX;
+static const hostReg A = R8;
+static const hostReg BC = R9;
+static const hostReg DE = R10;
+static const hostReg HL = R11;
+static const hostReg SP = R12;
+// byte being loaded, stored or fed to the ALU & the address it's at
+static const hostReg VALUE = R13;
+static const hostReg ADDRESS = R14;
+
+static const int A_OFFSET = offsetof(Registers, af) + 1; // A is the high byte
+static const int BC_OFFSET = offsetof(Registers, bc);
+static const int DE_OFFSET = offsetof(Registers, de);
+static const int HL_OFFSET = offsetof(Registers, hl);
+static const int SP_OFFSET = offsetof(Registers, sp);
+static const int PC_OFFSET = offsetof(Registers, pc);
+
+static const int ZERO_OFFSET = offsetof(lazyFlags, zeroResult);
+static const int NEGATIVE_OFFSET = offsetof(lazyFlags, negative);
+static const int HALF_OFFSET = offsetof(lazyFlags, halfBits);
+static const int CARRY_OFFSET = offsetof(lazyFlags, carryBits);
+
+// register pairs in opcode order: BC, DE, HL & SP
+static const hostReg pairs[4] = { BC, DE, HL, SP };
+
+static bool isHigh(int reg) { return reg == 0 || reg == 2 || reg == 4; }
+static hostReg pairOf(int reg) { return pairs[reg >> 1]; }
+
+static uint32_t result(int cycles, int count, int extra)
+{
+	return cycles | (count << 16) | (extra << 24);
+}
+
+namespace {
+
+// a way out of the block, jumped to from somewhere in the body
+struct exitStub
+{
+	int jump;
+	WORD pc;
+	uint32_t result;
+};
+
+/*
+ * Emits one block. Instructions are numbered from 0 & exits record how
+ * far through the block they leave.
+ */
+class translator
+{
+	public:
+		translator(WORD start): pc(start) {}
+
+		Emitter e;
+		WORD pc;
+		vector<exitStub> exits;
+		vector<int> epilogueJumps;
+
+		/*
+		 * Operand registers in opcode order: B, C, D, E, H, L, (HL), A.
+		 * Byte values are read zero extended into dst; writes take a value
+		 * under 0x100 in src, which is clobbered.
+		 */
+		void readRegister(int reg, hostReg dst)
+		{
+			if (reg == 7) {
+				e.mov(dst, A);
+			} else if (isHigh(reg)) {
+				e.mov(dst, pairOf(reg));
+				e.shiftImm(SHIFT_SHR, dst, 8);
+			} else {
+				e.movzx8(dst, pairOf(reg));
+			}
+		}
+
+		void writeRegister(int reg, hostReg src)
+		{
+			if (reg == 7) {
+				e.mov(A, src);
+			} else if (isHigh(reg)) {
+				e.aluImm(ALU_AND, pairOf(reg), 0x00ff);
+				e.shiftImm(SHIFT_SHL, src, 8);
+				e.alu(ALU_OR, pairOf(reg), src);
+			} else {
+				e.aluImm(ALU_AND, pairOf(reg), 0xff00);
+				e.alu(ALU_OR, pairOf(reg), src);
+			}
+		}
+
+		// leave at this instruction, before it's run, if the page is unmapped
+		void pageOrExit(hostReg pages, const exitStub& bail)
+		{
+			e.mov(RAX, ADDRESS);
+			e.shiftImm(SHIFT_SHR, RAX, 8);
+			e.load64Indexed(RAX, pages, RAX);
+			e.test64(RAX, RAX);
+			exitStub stub = bail;
+			stub.jump = e.jcc(COND_Z);
+			exits.push_back(stub);
+			e.movzx8(RBX, ADDRESS);
+		}
+
+		void readMemory(const exitStub& bail)
+		{
+			pageOrExit(READ_PAGES, bail);
+			e.load8Indexed(VALUE, RAX, RBX);
+		}
+
+		void writeMemory(const exitStub& bail)
+		{
+			pageOrExit(WRITE_PAGES, bail);
+			e.store8Indexed(RAX, RBX, VALUE);
+		}
+
+		// carry flag as 0 or 1 in dst
+		void carryIn(hostReg dst)
+		{
+			e.load32(dst, FLAGS, CARRY_OFFSET);
+			e.shiftImm(SHIFT_SHR, dst, 8);
+			e.aluImm(ALU_AND, dst, 1);
+		}
+
+		/*
+		 * A op VALUE, the same sums as CPU::add/adc/subtract/sbc/andd/
+		 * xorr/orr/cp so the lazy flags come out identical.
+		 */
+		void arithmetic(int op)
+		{
+			switch(op)
+			{
+				case 4: case 5: case 6:
+				{
+					static const aluOp logic[3] = { ALU_AND, ALU_XOR, ALU_OR };
+					e.alu(logic[op - 4], A, VALUE);
+					e.store8(FLAGS, ZERO_OFFSET, A);
+					e.store8Imm(FLAGS, NEGATIVE_OFFSET, 0);
+					e.store32Imm(FLAGS, HALF_OFFSET, op == 4 ? 0x10 : 0);
+					e.store32Imm(FLAGS, CARRY_OFFSET, 0);
+					return;
+				}
+			}
+
+			bool subtract = op >= 2;
+			if (op == 1 || op == 3) {
+				carryIn(RBP);
+			}
+			e.mov(RAX, A);
+			e.alu(subtract ? ALU_SUB : ALU_ADD, RAX, VALUE);
+			if (op == 1 || op == 3) {
+				e.alu(subtract ? ALU_SUB : ALU_ADD, RAX, RBP);
+			}
+
+			e.mov(RBX, A);
+			e.alu(ALU_XOR, RBX, VALUE);
+			e.alu(ALU_XOR, RBX, RAX);
+			e.store32(FLAGS, HALF_OFFSET, RBX);
+			e.store32(FLAGS, CARRY_OFFSET, RAX);
+			e.store8Imm(FLAGS, NEGATIVE_OFFSET, subtract ? 1 : 0);
+			e.store8(FLAGS, ZERO_OFFSET, RAX);
+
+			// cp only keeps the flags
+			if (op != 7) {
+				e.movzx8(A, RAX);
+			}
+		}
+
+		// INC r & DEC r, carry is left alone
+		void incrementRegister(int reg, bool down)
+		{
+			readRegister(reg, VALUE);
+			e.mov(RAX, VALUE);
+			e.aluImm(down ? ALU_SUB : ALU_ADD, RAX, 1);
+			e.movzx8(RAX, RAX);
+
+			e.mov(RBX, VALUE);
+			e.alu(ALU_XOR, RBX, RAX);
+			e.aluImm(ALU_XOR, RBX, 1);
+			e.store32(FLAGS, HALF_OFFSET, RBX);
+			e.store8Imm(FLAGS, NEGATIVE_OFFSET, down ? 1 : 0);
+			e.store8(FLAGS, ZERO_OFFSET, RAX);
+
+			writeRegister(reg, RAX);
+		}
+
+		// ADD HL, rr with the carries out of bits 11 & 15 moved down a byte
+		void addWord(hostReg src)
+		{
+			e.mov(RAX, HL);
+			e.alu(ALU_ADD, RAX, src);
+			e.mov(RBX, HL);
+			e.alu(ALU_XOR, RBX, src);
+			e.alu(ALU_XOR, RBX, RAX);
+			e.shiftImm(SHIFT_SHR, RBX, 8);
+			e.store32(FLAGS, HALF_OFFSET, RBX);
+			e.mov(RBP, RAX);
+			e.shiftImm(SHIFT_SHR, RBP, 8);
+			e.store32(FLAGS, CARRY_OFFSET, RBP);
+			e.store8Imm(FLAGS, NEGATIVE_OFFSET, 0);
+
+			e.mov(HL, RAX);
+			e.aluImm(ALU_AND, HL, 0xffff);
+		}
+
+		void stepPair(hostReg pair, int by)
+		{
+			e.aluImm(ALU_ADD, pair, by);
+			e.aluImm(ALU_AND, pair, 0xffff);
+		}
+
+		/*
+		 * The CB rotates & shifts in opcode order: RLC, RRC, RL, RR, SLA,
+		 * SRA, SWAP & SRL, mirroring CPU::rlc etc. C gets the bit shifted
+		 * out moved to bit 8.
+		 */
+		void shift(int kind, int reg)
+		{
+			bool left = kind == 0 || kind == 2 || kind == 4;
+
+			readRegister(reg, VALUE);
+			if (kind == 2 || kind == 3) {
+				carryIn(RBP);
+			}
+
+			// carry
+			if (kind == 6) {
+				e.movImm(RBX, 0);
+			} else {
+				e.mov(RBX, VALUE);
+				e.shiftImm(SHIFT_SHL, RBX, left ? 1 : 8);
+			}
+
+			e.mov(RAX, VALUE);
+			e.shiftImm(left ? SHIFT_SHL : SHIFT_SHR, RAX, kind == 6 ? 4 : 1);
+			switch(kind)
+			{
+				// bit 7 comes back round
+				case 0:
+					e.mov(RBP, VALUE);
+					e.shiftImm(SHIFT_SHR, RBP, 7);
+					break;
+				case 1:
+					e.mov(RBP, VALUE);
+					e.shiftImm(SHIFT_SHL, RBP, 7);
+					break;
+				case 3:
+					e.shiftImm(SHIFT_SHL, RBP, 7);
+					break;
+				// sign is kept
+				case 5:
+					e.mov(RBP, VALUE);
+					e.aluImm(ALU_AND, RBP, 0x80);
+					break;
+				case 6:
+					e.mov(RBP, VALUE);
+					e.shiftImm(SHIFT_SHL, RBP, 4);
+					break;
+			}
+			if (kind != 4 && kind != 7) {
+				e.alu(ALU_OR, RAX, RBP);
+			}
+			e.movzx8(RAX, RAX);
+
+			e.store32(FLAGS, CARRY_OFFSET, RBX);
+			e.store32Imm(FLAGS, HALF_OFFSET, 0);
+			e.store8Imm(FLAGS, NEGATIVE_OFFSET, 0);
+			e.store8(FLAGS, ZERO_OFFSET, RAX);
+			writeRegister(reg, RAX);
+		}
+
+		// BIT, RES & SET, carry is left alone
+		void bitOp(BYTE op)
+		{
+			int reg = op & 7;
+			int bit = 1 << ((op >> 3) & 7);
+			if (op < 0x80)
+			{
+				readRegister(reg, VALUE);
+				e.aluImm(ALU_AND, VALUE, bit);
+				e.store8(FLAGS, ZERO_OFFSET, VALUE);
+				e.store8Imm(FLAGS, NEGATIVE_OFFSET, 0);
+				e.store32Imm(FLAGS, HALF_OFFSET, 0x10);
+				return;
+			}
+
+			hostReg dst = reg == 7 ? A : pairOf(reg);
+			if (reg != 7 && isHigh(reg)) {
+				bit <<= 8;
+			}
+			if (op < 0xc0) {
+				e.aluImm(ALU_AND, dst, ~bit);
+			} else {
+				e.aluImm(ALU_OR, dst, bit);
+			}
+		}
+
+		/*
+		 * The stack through the page tables. Both pages are looked up
+		 * before anything is written, so leaving part way can't happen.
+		 */
+		void stackPages(const exitStub& bail)
+		{
+			e.mov(ADDRESS, SP);
+			e.aluImm(ALU_SUB, ADDRESS, 2);
+			e.aluImm(ALU_AND, ADDRESS, 0xffff);
+			pageOrExit(WRITE_PAGES, bail);
+			e.mov64(R15, RAX);
+			e.mov(RBP, RBX);
+
+			e.aluImm(ALU_ADD, ADDRESS, 1);
+			e.aluImm(ALU_AND, ADDRESS, 0xffff);
+			pageOrExit(WRITE_PAGES, bail);
+		}
+
+		// low byte at SP - 2 through R15 & RBP, high byte through RAX & RBX
+		void push(hostReg pair, const exitStub& bail)
+		{
+			stackPages(bail);
+			e.movzx8(VALUE, pair);
+			e.store8Indexed(R15, RBP, VALUE);
+			e.mov(VALUE, pair);
+			e.shiftImm(SHIFT_SHR, VALUE, 8);
+			e.store8Indexed(RAX, RBX, VALUE);
+
+			e.aluImm(ALU_SUB, SP, 2);
+			e.aluImm(ALU_AND, SP, 0xffff);
+		}
+
+		void pushImm(WORD value, const exitStub& bail)
+		{
+			stackPages(bail);
+			e.movImm(VALUE, value & 0xff);
+			e.store8Indexed(R15, RBP, VALUE);
+			e.movImm(VALUE, value >> 8);
+			e.store8Indexed(RAX, RBX, VALUE);
+
+			e.aluImm(ALU_SUB, SP, 2);
+			e.aluImm(ALU_AND, SP, 0xffff);
+		}
+
+		// popped word in RBP
+		void pop(const exitStub& bail)
+		{
+			e.mov(ADDRESS, SP);
+			readMemory(bail);
+			e.mov(RBP, VALUE);
+			e.aluImm(ALU_ADD, ADDRESS, 1);
+			e.aluImm(ALU_AND, ADDRESS, 0xffff);
+			readMemory(bail);
+			e.shiftImm(SHIFT_SHL, VALUE, 8);
+			e.alu(ALU_OR, RBP, VALUE);
+
+			e.aluImm(ALU_ADD, SP, 2);
+			e.aluImm(ALU_AND, SP, 0xffff);
+		}
+
+		// leave with PC at next
+		void leave(WORD next, uint32_t value)
+		{
+			e.store16Imm(REGS, PC_OFFSET, next);
+			e.movImm(RAX, value);
+			epilogueJumps.push_back(e.jmp());
+		}
+
+		// leave with PC taken from a register
+		void leaveTo(hostReg next, uint32_t value)
+		{
+			e.store16(REGS, PC_OFFSET, next);
+			e.movImm(RAX, value);
+			epilogueJumps.push_back(e.jmp());
+		}
+
+		// jump to taken if condition (NZ, Z, NC, C) holds
+		int branchIf(int cond)
+		{
+			if (cond < 2) {
+				e.cmp8Imm(FLAGS, ZERO_OFFSET, 0);
+				return e.jcc(cond == 0 ? COND_NZ : COND_Z);
+			}
+			e.test32Imm(FLAGS, CARRY_OFFSET, 0x100);
+			return e.jcc(cond == 2 ? COND_Z : COND_NZ);
+		}
+
+		void prologue()
+		{
+			e.push(RBX);
+			e.push(RBP);
+			e.push(R12);
+			e.push(R13);
+			e.push(R14);
+			e.push(R15);
+
+			e.load8(A, REGS, A_OFFSET);
+			e.load16(BC, REGS, BC_OFFSET);
+			e.load16(DE, REGS, DE_OFFSET);
+			e.load16(HL, REGS, HL_OFFSET);
+			e.load16(SP, REGS, SP_OFFSET);
+		}
+
+		// exit stubs out of line, then one shared write back
+		void epilogue()
+		{
+			for (size_t i = 0; i < exits.size(); i++)
+			{
+				e.bind(exits[i].jump);
+				leave(exits[i].pc, exits[i].result);
+			}
+
+			for (size_t i = 0; i < epilogueJumps.size(); i++)
+			{
+				e.bind(epilogueJumps[i]);
+			}
+
+			e.store8(REGS, A_OFFSET, A);
+			e.store16(REGS, BC_OFFSET, BC);
+			e.store16(REGS, DE_OFFSET, DE);
+			e.store16(REGS, HL_OFFSET, HL);
+			e.store16(REGS, SP_OFFSET, SP);
+
+			e.pop(R15);
+			e.pop(R14);
+			e.pop(R13);
+			e.pop(R12);
+			e.pop(RBP);
+			e.pop(RBX);
+			e.ret();
+		}
+
+		/*
+		 * One instruction. bail leaves before it runs, taken is filled in
+		 * for the way out of a jump.
+		 */
+		void instruction(const decodedInstruction& instr, const exitStub& bail, exitStub taken)
+		{
+			BYTE op = instr.opcode;
+			WORD next = pc + instr.length;
+
+			if (op >= 0x40 && op < 0x80)
+			{
+				int dst = (op >> 3) & 7;
+				int src = op & 7;
+				if (src == 6) {
+					e.mov(ADDRESS, HL);
+					readMemory(bail);
+					writeRegister(dst, VALUE);
+				} else if (dst == 6) {
+					readRegister(src, VALUE);
+					e.mov(ADDRESS, HL);
+					writeMemory(bail);
+				} else if (src != dst) {
+					readRegister(src, VALUE);
+					writeRegister(dst, VALUE);
+				}
+				return;
+			}
+
+			if (op >= 0x80 && op < 0xc0)
+			{
+				if ((op & 7) == 6) {
+					e.mov(ADDRESS, HL);
+					readMemory(bail);
+				} else {
+					readRegister(op & 7, VALUE);
+				}
+				arithmetic((op >> 3) & 7);
+				return;
+			}
+
+			switch(op & 0xc7)
+			{
+				case 0x04:
+					incrementRegister((op >> 3) & 7, false);
+					return;
+				case 0x05:
+					incrementRegister((op >> 3) & 7, true);
+					return;
+				case 0x06:
+					e.movImm(VALUE, instr.operand & 0xff);
+					writeRegister((op >> 3) & 7, VALUE);
+					return;
+				case 0xc6:
+					e.movImm(VALUE, instr.operand & 0xff);
+					arithmetic((op >> 3) & 7);
+					return;
+			}
+
+			switch(op & 0xcf)
+			{
+				case 0x01:
+					e.movImm(pairs[op >> 4], instr.operand);
+					return;
+				case 0x03:
+					stepPair(pairs[op >> 4], 1);
+					return;
+				case 0x0b:
+					stepPair(pairs[op >> 4], -1);
+					return;
+				case 0x09:
+					addWord(pairs[op >> 4]);
+					return;
+			}
+
+			switch(op)
+			{
+				case 0x00:
+					return;
+				// LD (BC), A & LD (DE), A
+				case 0x02: case 0x12:
+					e.mov(ADDRESS, pairs[op >> 4]);
+					e.mov(VALUE, A);
+					writeMemory(bail);
+					return;
+				// LD A, (BC) & LD A, (DE)
+				case 0x0a: case 0x1a:
+					e.mov(ADDRESS, pairs[op >> 4]);
+					readMemory(bail);
+					e.mov(A, VALUE);
+					return;
+				// LDI & LDD (HL), A
+				case 0x22: case 0x32:
+					e.mov(ADDRESS, HL);
+					e.mov(VALUE, A);
+					writeMemory(bail);
+					stepPair(HL, op == 0x22 ? 1 : -1);
+					return;
+				// LDI & LDD A, (HL)
+				case 0x2a: case 0x3a:
+					e.mov(ADDRESS, HL);
+					readMemory(bail);
+					e.mov(A, VALUE);
+					stepPair(HL, op == 0x2a ? 1 : -1);
+					return;
+				case 0xea:
+					e.movImm(ADDRESS, instr.operand);
+					e.mov(VALUE, A);
+					writeMemory(bail);
+					return;
+				case 0xfa:
+					e.movImm(ADDRESS, instr.operand);
+					readMemory(bail);
+					e.mov(A, VALUE);
+					return;
+				// RLCA, RRCA, RLA & RRA are the CB rotates that never set Z
+				case 0x07: case 0x0f: case 0x17: case 0x1f:
+					shift(op >> 3, 7);
+					e.store8Imm(FLAGS, ZERO_OFFSET, 1);
+					return;
+				case 0xcb:
+					if (instr.operand < 0x40) {
+						shift(instr.operand >> 3, instr.operand & 7);
+					} else {
+						bitOp(instr.operand);
+					}
+					return;
+				// PUSH & POP BC, DE & HL
+				case 0xc5: case 0xd5: case 0xe5:
+					push(pairs[(op >> 4) & 3], bail);
+					return;
+				case 0xc1: case 0xd1: case 0xe1:
+					pop(bail);
+					e.mov(pairs[(op >> 4) & 3], RBP);
+					return;
+				// CALL nn & CALL cc, nn, 12 cycles more when taken
+				case 0xcd:
+					pushImm(next, bail);
+					leave(instr.operand, taken.result);
+					return;
+				case 0xc4: case 0xcc: case 0xd4: case 0xdc:
+				{
+					int skip = branchIf(((op >> 3) & 3) ^ 1);
+					pushImm(next, bail);
+					leave(instr.operand, taken.result | (12 << 24));
+					e.bind(skip);
+					return;
+				}
+				// RET & RET cc, 12 cycles more when taken
+				case 0xc9:
+					pop(bail);
+					leaveTo(RBP, taken.result);
+					return;
+				case 0xc0: case 0xc8: case 0xd0: case 0xd8:
+				{
+					int skip = branchIf(((op >> 3) & 3) ^ 1);
+					pop(bail);
+					leaveTo(RBP, taken.result | (12 << 24));
+					e.bind(skip);
+					return;
+				}
+				// JP (HL)
+				case 0xe9:
+					leaveTo(HL, taken.result);
+					return;
+				// CPL
+				case 0x2f:
+					e.aluImm(ALU_XOR, A, 0xff);
+					e.store32Imm(FLAGS, HALF_OFFSET, 0x10);
+					e.store8Imm(FLAGS, NEGATIVE_OFFSET, 1);
+					return;
+				// SCF
+				case 0x37:
+					e.store32Imm(FLAGS, CARRY_OFFSET, 0x100);
+					e.store8Imm(FLAGS, NEGATIVE_OFFSET, 0);
+					e.store32Imm(FLAGS, HALF_OFFSET, 0);
+					return;
+				// CCF
+				case 0x3f:
+					e.load32(RAX, FLAGS, CARRY_OFFSET);
+					e.aluImm(ALU_XOR, RAX, -1);
+					e.aluImm(ALU_AND, RAX, 0x100);
+					e.store32(FLAGS, CARRY_OFFSET, RAX);
+					e.store8Imm(FLAGS, NEGATIVE_OFFSET, 0);
+					e.store32Imm(FLAGS, HALF_OFFSET, 0);
+					return;
+				// JR n & JP nn
+				case 0x18: case 0xc3:
+					taken.pc = op == 0x18 ? (WORD) (next + (SIGNED_BYTE) instr.operand) : instr.operand;
+					leave(taken.pc, taken.result);
+					return;
+				// JR cc, n & JP cc, nn, 4 cycles more when taken
+				case 0x20: case 0x28: case 0x30: case 0x38:
+				case 0xc2: case 0xca: case 0xd2: case 0xda:
+					taken.pc = op < 0x40 ? (WORD) (next + (SIGNED_BYTE) instr.operand) : instr.operand;
+					taken.result |= 4 << 24;
+					taken.jump = branchIf((op >> 3) & 3);
+					exits.push_back(taken);
+					return;
+			}
+		}
+};
+
+}
+
+JIT::JIT():
+arena(NULL),
+used(0)
+{
+	void* memory = mmap(NULL, ARENA_SIZE, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (memory != MAP_FAILED)
+	{
+		arena = (BYTE*) memory;
+	}
+}
+
+JIT::~JIT()
+{
+	if (arena != NULL)
+	{
+		munmap(arena, ARENA_SIZE);
+	}
+}
+
+/*
+ * The arena is never writable & executable at once: only the pages the new
+ * code lands on are opened for writing, then closed again.
+ */
+BYTE* JIT::place(const BYTE* code, size_t length)
+{
+	size_t start = (used + 15) & ~(size_t) 15;
+	if (arena == NULL || start + length > ARENA_SIZE)
+	{
+		return NULL;
+	}
+
+	size_t page = sysconf(_SC_PAGESIZE);
+	size_t first = start & ~(page - 1);
+	size_t last = (start + length + page - 1) & ~(page - 1);
+	if (mprotect(arena + first, last - first, PROT_READ | PROT_WRITE) != 0)
+	{
+		return NULL;
+	}
+	memcpy(arena + start, code, length);
+	mprotect(arena + first, last - first, PROT_READ | PROT_EXEC);
+
+	used = start + length;
+	return arena + start;
+}
+
+bool JIT::supports(const decodedInstruction& instr)
+{
+	BYTE op = instr.opcode;
+
+	// loads between registers & (HL), HALT aside
+	if (op >= 0x40 && op < 0x80) {
+		return op != 0x76;
+	}
+	// ALU ops on registers & (HL)
+	if (op >= 0x80 && op < 0xc0) {
+		return true;
+	}
+
+	switch(op)
+	{
+		// INC r, DEC r & LD r, n bar (HL)
+		case 0x04: case 0x0c: case 0x14: case 0x1c: case 0x24: case 0x2c: case 0x3c:
+		case 0x05: case 0x0d: case 0x15: case 0x1d: case 0x25: case 0x2d: case 0x3d:
+		case 0x06: case 0x0e: case 0x16: case 0x1e: case 0x26: case 0x2e: case 0x3e:
+		// 16 bit loads, increments & adds
+		case 0x01: case 0x11: case 0x21: case 0x31:
+		case 0x03: case 0x13: case 0x23: case 0x33:
+		case 0x0b: case 0x1b: case 0x2b: case 0x3b:
+		case 0x09: case 0x19: case 0x29: case 0x39:
+		// memory through BC, DE, HL & nn
+		case 0x02: case 0x12: case 0x0a: case 0x1a:
+		case 0x22: case 0x32: case 0x2a: case 0x3a:
+		case 0xea: case 0xfa:
+		// ALU ops with an immediate
+		case 0xc6: case 0xce: case 0xd6: case 0xde: case 0xe6: case 0xee: case 0xf6: case 0xfe:
+		// rotates of A & flag ops
+		case 0x00: case 0x07: case 0x0f: case 0x17: case 0x1f:
+		case 0x2f: case 0x37: case 0x3f:
+		// stack ops bar AF
+		case 0xc5: case 0xd5: case 0xe5: case 0xc1: case 0xd1: case 0xe1:
+		// jumps, calls & returns, RETI & RST aside
+		case 0x18: case 0x20: case 0x28: case 0x30: case 0x38:
+		case 0xc3: case 0xc2: case 0xca: case 0xd2: case 0xda: case 0xe9:
+		case 0xcd: case 0xc4: case 0xcc: case 0xd4: case 0xdc:
+		case 0xc9: case 0xc0: case 0xc8: case 0xd0: case 0xd8:
+			return true;
+		// CB ops on registers
+		case 0xcb:
+			return (instr.operand & 7) != 6;
+		default:
+			return false;
+	}
+}
+
+bool JIT::compile(block& decoded, WORD pc, const BYTE* cycles)
+{
+	int count = 0;
+	while (count < decoded.count && supports(decoded.instructions[count]))
+	{
+		count++;
+	}
+	if (count == 0)
+	{
+		return false;
+	}
+
+	translator t(pc);
+	t.prologue();
+
+	int total = 0;
+	for (int i = 0; i < count; i++)
+	{
+		const decodedInstruction& instr = decoded.instructions[i];
+
+		exitStub bail = { 0, t.pc, result(total, i, 0) };
+		exitStub taken = { 0, 0, result(total + cycles[i], i + 1, 0) };
+		t.instruction(instr, bail, taken);
+
+		total += cycles[i];
+		t.pc += instr.length;
+	}
+
+	// fall through to the next instruction, or the jump wasn't taken
+	BYTE last = decoded.instructions[count - 1].opcode;
+	if (last != 0x18 && last != 0xc3 && last != 0xcd && last != 0xc9 && last != 0xe9)
+	{
+		t.leave(t.pc, result(total, count, 0));
+	}
+	t.epilogue();
+
+	BYTE* code = place(&t.e.code()[0], t.e.size());
+	if (code == NULL)
+	{
+		return false;
+	}
+
+	decoded.native = (nativeBlock) code;
+	decoded.nativeCount = count;
+	decoded.nativeCycles = total - cycles[count - 1];
+	decoded.nativePC = pc;
+	return true;
+}
+
+#endif
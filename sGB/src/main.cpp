@@ -1,12 +1,11 @@
 #include <iostream>
 #include <string>
+#include <cstring>
 #include <SDL.h>
 #include "res_path.hpp"
 #include "cleanup.hpp"
 #include "sGBEmulator.hpp"
 
-const int SCREEN_WIDTH = 160;
-const int SCREEN_HEIGHT = 144;
 int WINDOW_SCALE = 2;
 
 using namespace std;
@@ -20,6 +19,78 @@ void logSDLError(ostream &os, const string &msg){
 	os << msg << " error: " << SDL_GetError() << endl;
 }
 
+/**
+* Pick one of the renderer's own texture formats that takes the gpu's
+* 0xAARRGGBB pixels as they are, so SDL never has to convert on upload
+* @param renderer The renderer the screen texture is made for
+* @return ARGB8888 or RGB888 (alpha ignored), ARGB8888 if neither is native
+*/
+Uint32 screenFormat(SDL_Renderer *renderer){
+	SDL_RendererInfo info;
+	if (SDL_GetRendererInfo(renderer, &info) == 0)
+	{
+		for (Uint32 i = 0; i < info.num_texture_formats; i++)
+		{
+			Uint32 format = info.texture_formats[i];
+			if (format == SDL_PIXELFORMAT_ARGB8888 || format == SDL_PIXELFORMAT_RGB888)
+			{
+				return format;
+			}
+		}
+	}
+	return SDL_PIXELFORMAT_ARGB8888;
+}
+
+/**
+* Copy the rows the gpu changed into the streaming screen texture. Each run
+* of consecutive rows is locked on its own, so only those get uploaded
+* @param texture The SCREEN_WIDTH x SCREEN_HEIGHT streaming texture
+* @param framebuffer The gpu's pixels
+* @param dirtyRows Which rows changed since the last upload, cleared as
+* they're uploaded so rows that fail stay dirty for the next frame
+* @param uploaded Incremented by the number of rows uploaded
+* @return Whether every dirty row was uploaded
+*/
+bool uploadRows(SDL_Texture *texture, const PIXEL *framebuffer, bool *dirtyRows, Uint64 &uploaded){
+	for (int first = 0; first < SCREEN_HEIGHT; first++)
+	{
+		if (!dirtyRows[first])
+		{
+			continue;
+		}
+
+		int last = first;
+		while (last + 1 < SCREEN_HEIGHT && dirtyRows[last + 1])
+		{
+			last++;
+		}
+
+		SDL_Rect rows = { 0, first, SCREEN_WIDTH, last - first + 1 };
+		void *pixels;
+		int pitch;
+		if (SDL_LockTexture(texture, &rows, &pixels, &pitch) != 0)
+		{
+			logSDLError(cout, "SDL_LockTexture");
+			return false;
+		}
+
+		// locked memory is write only, every pixel of it gets overwritten
+		for (int y = first; y <= last; y++)
+		{
+			memcpy((Uint8*) pixels + (y - first) * pitch, framebuffer + y * SCREEN_WIDTH, SCREEN_WIDTH * sizeof(PIXEL));
+		}
+		SDL_UnlockTexture(texture);
+
+		for (int y = first; y <= last; y++)
+		{
+			dirtyRows[y] = false;
+		}
+		uploaded += rows.h;
+		first = last;
+	}
+	return true;
+}
+
 int main (int argc, char** argv)
 {
 	// check for a filename of the game...
@@ -64,11 +135,34 @@ int main (int argc, char** argv)
 		return 1;
 	}
 
+	// the screen is stretched by WINDOW_SCALE, keep the pixels square & sharp
+	SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
+	SDL_Texture *pScreen = SDL_CreateTexture(pRenderer,
+											screenFormat(pRenderer),
+											SDL_TEXTUREACCESS_STREAMING,
+											SCREEN_WIDTH,
+											SCREEN_HEIGHT);
+	if (pScreen == nullptr)
+	{
+		logSDLError(cout, "SDL_CreateTexture");
+		return 1;
+	}
+
 	sGBEmulator sGB(romPath);
+	// a minute of history, played back while backspace is held
+	sGB.setRewindLength(60 * REFRESHRATE);
+	const Uint8* keys = SDL_GetKeyboardState(NULL);
 
 	SDL_Event e;
 	bool running = true;
 
+	// presentation cost: uploading rows & drawing the scaled screen. SDL
+	// batches draws until a flush, SDL_RenderPresent only adds the wait for
+	// vsync so isn't counted
+	Uint64 presentTicks = 0;
+	Uint64 presentFrames = 0;
+	Uint64 rowsUploaded = 0;
+
 	while (running)
 	{
 		while (SDL_PollEvent(&e))
@@ -79,18 +173,41 @@ int main (int argc, char** argv)
 			}
 		}
 
-		bool success = sGB.update();
-		if (!success)
+		if (keys[SDL_SCANCODE_BACKSPACE])
+		{
+			// stays on the oldest frame once the history runs out
+			sGB.rewind();
+		} else
 		{
-			running = false;;
+			bool success = sGB.update();
+			if (!success)
+			{
+				running = false;;
+			}
 		}
-		
+
+		Uint64 start = SDL_GetPerformanceCounter();
+		// rows that failed to upload are retried next frame
+		uploadRows(pScreen, sGB.getFramebuffer(), sGB.getDirtyRows(), rowsUploaded);
+
 		SDL_RenderClear(pRenderer);
+		SDL_RenderCopy(pRenderer, pScreen, NULL, NULL);
+		SDL_RenderFlush(pRenderer);
+		presentTicks += SDL_GetPerformanceCounter() - start;
+		presentFrames++;
 
 		SDL_RenderPresent(pRenderer);
 	}
 
-	cleanup(pRenderer, pWindow);
+	if (presentFrames > 0)
+	{
+		double frequency = (double) SDL_GetPerformanceFrequency();
+		cout << "present at WINDOW_SCALE " << WINDOW_SCALE << ": "
+			<< presentTicks * 1000000.0 / frequency / presentFrames << " us/frame, "
+			<< (double) rowsUploaded / presentFrames << " rows uploaded/frame" << endl;
+	}
+
+	cleanup(pScreen, pRenderer, pWindow);
 	SDL_Quit();
 	return 0;
 }
\ No newline at end of file
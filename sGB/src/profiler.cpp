@@ -0,0 +1,172 @@
+#include "profiler.hpp"
+
+#ifdef SGB_PROFILE
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+Profiler::Profiler() :
+romBanks(0),
+depth(0),
+current(0)
+{
+	nodes.reserve(MAX_NODES);
+	reset(2);
+}
+
+void Profiler::reset(int banks)
+{
+	romBanks = banks;
+	counts.assign(romBanks * 0x4000 + 0x8000, 0);
+	memset(opcodeCounts, 0, sizeof(opcodeCounts));
+	memset(opcodeCycles, 0, sizeof(opcodeCycles));
+	totalInstructions = 0;
+	totalCycles = 0;
+
+	node root = {-1, -1, -1, -1, 0};
+	nodes.clear();
+	nodes.push_back(root);
+	depth = 0;
+	current = 0;
+}
+
+/*
+ * Calls into the same function from the same stack share a node. Once the
+ * tree is full new stacks are counted against their caller.
+ */
+void Profiler::call(int bank, WORD target, WORD sp)
+{
+	int64_t function = target < 0x8000 ? ((int64_t) bank << 16) | target : target;
+
+	int callee = nodes[current].child;
+	while (callee >= 0 && nodes[callee].function != function)
+	{
+		callee = nodes[callee].sibling;
+	}
+
+	if (callee < 0 && (int) nodes.size() < MAX_NODES)
+	{
+		node added = {function, current, -1, nodes[current].child, 0};
+		callee = nodes.size();
+		nodes.push_back(added);
+		nodes[current].child = callee;
+	}
+	if (callee < 0)
+	{
+		callee = current;
+	}
+
+	if (depth < MAX_DEPTH)
+	{
+		stack[depth].node = callee;
+		stack[depth].sp = sp;
+		depth++;
+		current = callee;
+	}
+}
+
+/*
+ * Frames are matched by stack pointer rather than counted, so code that
+ * drops return addresses off the stack by hand still unwinds properly
+ */
+void Profiler::ret(WORD sp)
+{
+	while (depth > 0 && stack[depth - 1].sp < sp)
+	{
+		depth--;
+	}
+	current = depth > 0 ? stack[depth - 1].node : 0;
+}
+
+void Profiler::writeReport(ostream& out, const vector<const char*>& names, size_t top)
+{
+	char line[128];
+
+	snprintf(line, sizeof(line), "instructions: %llu\ncycles: %llu\n\n",
+		(unsigned long long) totalInstructions, (unsigned long long) totalCycles);
+	out << line;
+
+	vector<size_t> hot;
+	for (size_t i = 0; i < counts.size(); i++)
+	{
+		if (counts[i] > 0)
+		{
+			hot.push_back(i);
+		}
+	}
+	top = min(top, hot.size());
+	partial_sort(hot.begin(), hot.begin() + top, hot.end(),
+		[this](size_t a, size_t b) { return counts[a] > counts[b]; });
+
+	out << "hot spots (bank:pc, executions, share of instructions)" << endl;
+	size_t romSlots = romBanks * 0x4000;
+	for (size_t i = 0; i < top; i++)
+	{
+		size_t slot = hot[i];
+		int bank = slot < romSlots ? slot / 0x4000 : 0;
+		int pc = slot < romSlots ? (slot & 0x3fff) | (bank ? 0x4000 : 0) : slot - romSlots + 0x8000;
+		snprintf(line, sizeof(line), "  %02x:%04x %14llu %6.2f%%\n", bank, pc,
+			(unsigned long long) counts[slot], 100.0 * counts[slot] / totalInstructions);
+		out << line;
+	}
+
+	vector<int> opcodes;
+	for (int i = 0; i < 0x200; i++)
+	{
+		if (opcodeCounts[i] > 0)
+		{
+			opcodes.push_back(i);
+		}
+	}
+	sort(opcodes.begin(), opcodes.end(),
+		[this](int a, int b) { return opcodeCycles[a] > opcodeCycles[b]; });
+
+	out << endl << "opcodes (executions, cycles, share of cycles)" << endl;
+	for (size_t i = 0; i < opcodes.size(); i++)
+	{
+		int opcode = opcodes[i];
+		snprintf(line, sizeof(line), "  %s%02x %-18s %14llu %14llu %6.2f%%\n",
+			opcode >= 0x100 ? "cb " : "   ", opcode & 0xff, names[opcode],
+			(unsigned long long) opcodeCounts[opcode], (unsigned long long) opcodeCycles[opcode],
+			100.0 * opcodeCycles[opcode] / totalCycles);
+		out << line;
+	}
+}
+
+void Profiler::writeCollapsed(ostream& out)
+{
+	for (size_t i = 0; i < nodes.size(); i++)
+	{
+		if (nodes[i].cycles > 0)
+		{
+			writeStack(out, i);
+			out << " " << nodes[i].cycles << "\n";
+		}
+	}
+}
+
+// callers first, functions named bank:address like a .sym file
+void Profiler::writeStack(ostream& out, int index)
+{
+	if (nodes[index].parent >= 0)
+	{
+		writeStack(out, nodes[index].parent);
+		out << ";";
+	}
+
+	int64_t function = nodes[index].function;
+	if (function < 0)
+	{
+		out << "start";
+		return;
+	}
+
+	char name[16];
+	snprintf(name, sizeof(name), "%02x:%04x", (int) (function >> 16), (int) (function & 0xffff));
+	out << name;
+}
+
+#endif
@@ -0,0 +1,229 @@
+#include "rewind.hpp"
+#include <cstring>
+#include <utility>
+
+using namespace std;
+
+RewindBuffer::RewindBuffer(size_t frames, size_t keyframeInterval) :
+maxFrames(frames),
+keyframeInterval(keyframeInterval),
+sinceKeyframe(0),
+encodedBytes(0)
+{
+
+}
+
+void RewindBuffer::setCapacity(size_t frames)
+{
+	maxFrames = frames;
+	if (maxFrames == 0)
+	{
+		clear();
+		newest.shrink_to_fit();
+		spare.shrink_to_fit();
+		return;
+	}
+
+	while (entries.size() > maxFrames)
+	{
+		dropOldest();
+	}
+}
+
+void RewindBuffer::clear()
+{
+	entries.clear();
+	newest.clear();
+	sinceKeyframe = 0;
+	encodedBytes = 0;
+}
+
+void RewindBuffer::push(const vector<BYTE>& state)
+{
+	if (maxFrames == 0 || state.empty())
+	{
+		return;
+	}
+
+	// dropping a whole group at a time shouldn't empty a short buffer
+	size_t interval = keyframeInterval;
+	if (interval * 4 > maxFrames)
+	{
+		interval = maxFrames / 4 + 1;
+	}
+
+	entry added;
+	added.keyframe = entries.empty() || sinceKeyframe + 1 >= interval || newest.size() != state.size();
+	added.length = state.size();
+	added.data.swap(spare);
+	encode(&state[0], added.keyframe ? NULL : &newest[0], state.size(), added.data);
+
+	sinceKeyframe = added.keyframe ? 0 : sinceKeyframe + 1;
+	encodedBytes += added.data.size();
+	entries.push_back(move(added));
+	newest = state;
+
+	while (entries.size() > maxFrames)
+	{
+		dropOldest();
+	}
+}
+
+bool RewindBuffer::pop()
+{
+	if (entries.empty())
+	{
+		return false;
+	}
+
+	encodedBytes -= entries.back().data.size();
+	spare.swap(entries.back().data);
+	entries.pop_back();
+
+	sinceKeyframe = 0;
+	for (size_t i = entries.size(); i > 0 && !entries[i - 1].keyframe; i--)
+	{
+		sinceKeyframe++;
+	}
+
+	if (!get(0, newest))
+	{
+		newest.clear();
+	}
+	return true;
+}
+
+/*
+ * Decode the keyframe at or before the state then every delta up to it
+*/
+bool RewindBuffer::get(size_t back, vector<BYTE>& out) const
+{
+	if (back >= entries.size())
+	{
+		return false;
+	}
+
+	size_t target = entries.size() - 1 - back;
+	size_t first = target;
+	while (!entries[first].keyframe)
+	{
+		first--;
+	}
+
+	out.assign(entries[first].length, 0);
+	for (size_t i = first; i <= target; i++)
+	{
+		apply(entries[i].data, &out[0]);
+	}
+	return true;
+}
+
+/*
+ * Deltas lean on the state before them, so once the oldest keyframe goes
+ * the deltas after it have to go with it
+*/
+void RewindBuffer::dropOldest()
+{
+	do
+	{
+		encodedBytes -= entries.front().data.size();
+		spare.swap(entries.front().data);
+		entries.pop_front();
+	} while (!entries.empty() && !entries.front().keyframe);
+
+	if (entries.empty())
+	{
+		sinceKeyframe = 0;
+		newest.clear();
+	}
+}
+
+static void writeLength(vector<BYTE>& out, size_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back((value & 0x7f) | 0x80);
+		value >>= 7;
+	}
+	out.push_back(value);
+}
+
+static size_t readLength(const BYTE* data, size_t& position)
+{
+	size_t value = 0;
+	int shift = 0;
+	BYTE next;
+	do
+	{
+		next = data[position++];
+		value |= (size_t) (next & 0x7f) << shift;
+		shift += 7;
+	} while (next & 0x80);
+	return value;
+}
+
+/*
+ * state XOR base (or state itself without a base) as pairs of a zero run
+ * length & a literal run length followed by the literal bytes. Literal runs
+ * carry on over gaps shorter than 8 bytes, which cost less inline than a
+ * new pair.
+*/
+void RewindBuffer::encode(const BYTE* state, const BYTE* base, size_t length, vector<BYTE>& out)
+{
+	static const BYTE zeros[8] = {};
+	out.clear();
+
+	size_t i = 0;
+	while (i < length)
+	{
+		size_t zeroStart = i;
+		while (i + 8 <= length && memcmp(state + i, base ? base + i : zeros, 8) == 0)
+		{
+			i += 8;
+		}
+		while (i < length && state[i] == (base ? base[i] : 0))
+		{
+			i++;
+		}
+		if (i == length)
+		{
+			break;
+		}
+
+		size_t literalStart = i;
+		size_t same = 0;
+		while (i < length && same < 8)
+		{
+			same = (state[i] == (base ? base[i] : 0)) ? same + 1 : 0;
+			i++;
+		}
+		size_t literalEnd = i - same;
+
+		writeLength(out, literalStart - zeroStart);
+		writeLength(out, literalEnd - literalStart);
+		for (size_t j = literalStart; j < literalEnd; j++)
+		{
+			out.push_back(state[j] ^ (base ? base[j] : 0));
+		}
+		i = literalEnd;
+	}
+}
+
+void RewindBuffer::apply(const vector<BYTE>& encoded, BYTE* state)
+{
+	const BYTE* data = encoded.empty() ? NULL : &encoded[0];
+	size_t position = 0;
+	size_t at = 0;
+
+	while (position < encoded.size())
+	{
+		at += readLength(data, position);
+		size_t literals = readLength(data, position);
+		for (size_t j = 0; j < literals; j++)
+		{
+			state[at + j] ^= data[position + j];
+		}
+		position += literals;
+		at += literals;
+	}
+}
@@ -1,4 +1,15 @@
 #include "rom.hpp"
+#include "state.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 std::vector<std::string> initRomNames() 
 {
@@ -32,4 +43,121 @@ std::vector<std::string> initRomNames()
 	return names;
 }
 
-std::vector<std::string> romTypeNames = initRomNames();
\ No newline at end of file
+std::vector<std::string> romTypeNames = initRomNames();
+
+// images currently alive by resolved path, so opening the same ROM again
+// shares the mapping
+static std::mutex imagesLock;
+static std::map<std::string, std::weak_ptr<const ROMImage> > images;
+
+// absolute path with symlinks, . & .. resolved, or path as is if it can't be
+static std::string resolvePath(const std::string& path)
+{
+#ifndef _WIN32
+	char* resolved = realpath(path.c_str(), NULL);
+	if (resolved != NULL)
+	{
+		std::string result(resolved);
+		free(resolved);
+		return result;
+	}
+#endif
+	return path;
+}
+
+std::shared_ptr<const ROMImage> ROMImage::open(const std::string& path)
+{
+	std::string key = resolvePath(path);
+	std::lock_guard<std::mutex> lock(imagesLock);
+
+	std::shared_ptr<const ROMImage> image = images[key].lock();
+	if (image)
+	{
+		return image;
+	}
+
+	std::shared_ptr<ROMImage> loaded(new ROMImage());
+	if (!loaded->load(path))
+	{
+		images.erase(key);
+		return std::shared_ptr<const ROMImage>();
+	}
+	loaded->contentHash = hashBytes(loaded->bytes, loaded->length);
+
+	images[key] = loaded;
+	return loaded;
+}
+
+ROMImage::ROMImage() :
+bytes(NULL),
+length(0),
+contentHash(0),
+mappedLength(0)
+{
+
+}
+
+ROMImage::~ROMImage()
+{
+#ifndef _WIN32
+	if (mappedLength)
+	{
+		munmap((void*) bytes, mappedLength);
+	}
+#endif
+}
+
+bool ROMImage::load(const std::string& path)
+{
+#ifndef _WIN32
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) == 0)
+	{
+		size_t fileSize = st.st_size;
+
+		// banks are mapped 16kB at a time, anything short of whole banks
+		// would fault past the end of the file
+		if (fileSize >= 0x8000 && fileSize % 0x4000 == 0)
+		{
+			void* addr = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (addr != MAP_FAILED)
+			{
+				bytes = (const BYTE*) addr;
+				length = fileSize;
+				mappedLength = fileSize;
+			}
+		}
+	}
+	close(fd);
+
+	if (mappedLength)
+	{
+		return true;
+	}
+#endif
+
+	// otherwise keep a copy padded out to whole banks
+	std::ifstream romFile(path.c_str(), std::ifstream::binary);
+	if (!romFile.is_open())
+	{
+		return false;
+	}
+
+	romFile.seekg(0, romFile.end);
+	std::streamoff end = romFile.tellg();
+	size_t fileSize = end > 0 ? end : 0;
+	romFile.seekg(0, romFile.beg);
+
+	copy.assign(fileSize < 0x8000 ? 0x8000 : (fileSize + 0x3fff) & ~0x3fff, 0);
+	romFile.read((char*) &copy[0], fileSize);
+
+	bytes = &copy[0];
+	length = copy.size();
+	return true;
+}
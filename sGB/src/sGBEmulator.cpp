@@ -1,3 +1,6 @@
+#include <chrono>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include "constants.hpp"
 #include "sGBEmulator.hpp"
@@ -6,11 +9,26 @@ using namespace std;
 
 sGBEmulator::sGBEmulator(string romPath) : 
 romPath(romPath), 
-romFile(romPath.c_str(), ifstream::binary),
 cpu(new CPU()),
-gpu(new GPU()),
-timer(new Timer())
+gpu(new GPU(cpu->getMMU())),
+timer(new Timer(cpu->getMMU())),
+clock(cpu->getClock()),
+syncedCycles(0),
+deadline(0),
+stepping(false)
 {
+	memset(&perf, 0, sizeof(perf));
+	memset(&perfStart, 0, sizeof(perfStart));
+	perfStartTicks = 0;
+	memset(&perfTicksSpent, 0, sizeof(perfTicksSpent));
+
+	MMU* mmu = cpu->getMMU();
+	mmu->setTimingHandler([this]() { timingWrite(); });
+	// the timer is only ever read & written by the cpu, mid run
+	mmu->setTimerHandlers(
+		[this](WORD address) { return timer->read(address, clock->now()); },
+		[this](WORD address, BYTE value) { timer->write(address, value, clock->now()); });
+
 	bool success = initialize();
 	if (success) {
 		cout << "Initialization succeeded!" << endl;
@@ -23,9 +41,9 @@ bool sGBEmulator::initialize()
 {
 	cout << "Attempting to load rom from: " << romPath << endl;
 
-	if (romFile.is_open()) {
-		cpu->loadROM(romFile);
-		romFile.close();
+	rom = ROMImage::open(romPath);
+	if (rom) {
+		cpu->loadROM(rom);
 
 		cout << "Successfully loaded rom!" << endl;
 		return true;
@@ -35,44 +53,390 @@ bool sGBEmulator::initialize()
 	}
 }
 
+/*
+ * The cpu runs freely until the next scheduled event, the timer & gpu are
+ * then caught up in one go & report when they next change state. Nothing
+ * they expose changes in between, so this matches stepping them after every
+ * instruction.
+ */
 bool sGBEmulator::update()
 {
-	int cyclesThisUpdate = 0;
+	startPerfFrame();
 
-	while (cyclesThisUpdate < MAXCYCLES)
+	bool success = runFrame();
+	if (success && rewindBuffer.capacity() > 0)
 	{
-		int cycles = this->cpuStep();
-		if (cycles == -1)
+		// the picture is redrawn when rewinding, no need to keep it
+		writeState(rewindState, false);
+		rewindBuffer.push(rewindState);
+	}
+
+	endPerfFrame();
+	return success;
+}
+
+#ifdef SGB_PERF_COUNTERS
+static uint64_t steadyNanoseconds()
+{
+	return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/*
+ * Counters are kept as running totals, so a frame starts by noting them
+ * & ends by subtracting
+ */
+void sGBEmulator::startPerfFrame()
+{
+	MMU* mmu = cpu->getMMU();
+
+	memset(&perfTicksSpent, 0, sizeof(perfTicksSpent));
+	perfStart.updateTime = steadyNanoseconds();
+	perfStart.instructions = cpu->getInstructions();
+	perfStart.romBankSwitches = mmu->getROMSwitches();
+	memcpy(perfStart.reads, mmu->getRegionReads(), sizeof(perfStart.reads));
+	memcpy(perfStart.writes, mmu->getRegionWrites(), sizeof(perfStart.writes));
+	perfStartTicks = perfTicks();
+}
+
+void sGBEmulator::endPerfFrame()
+{
+	MMU* mmu = cpu->getMMU();
+
+	uint64_t ticks = perfTicks() - perfStartTicks;
+	uint64_t nanoseconds = steadyNanoseconds() - perfStart.updateTime;
+	// the TSC's rate isn't known, take it from the steady clock
+	double scale = ticks ? (double) nanoseconds / ticks : 0;
+
+	perf.frame++;
+	perf.updateTime = nanoseconds;
+	perf.cpuTime = perfTicksSpent.cpu * scale;
+	perf.timerTime = perfTicksSpent.timer * scale;
+	perf.gpuTime = perfTicksSpent.gpu * scale;
+	perf.interruptTime = perfTicksSpent.interrupt * scale;
+	perf.instructions = cpu->getInstructions() - perfStart.instructions;
+	perf.romBankSwitches = (unsigned int) (mmu->getROMSwitches() - perfStart.romBankSwitches);
+	for (int i = 0; i < REGION_COUNT; i++)
+	{
+		perf.reads[i] = mmu->getRegionReads()[i] - perfStart.reads[i];
+		perf.writes[i] = mmu->getRegionWrites()[i] - perfStart.writes[i];
+	}
+}
+#else
+void sGBEmulator::startPerfFrame()
+{
+
+}
+
+void sGBEmulator::endPerfFrame()
+{
+
+}
+#endif
+
+/*
+ * The newest recorded state is where the emulator is now. Replaying the
+ * frames leading up to the one to go back to draws its picture, then
+ * loading its state lands there exactly. A frame of emulation is a little
+ * shorter than the LCD's, it takes two to redraw every line.
+ */
+bool sGBEmulator::rewind()
+{
+	if (rewindBuffer.size() < 2)
+	{
+		return false;
+	}
+	rewindBuffer.pop();
+
+	size_t replay = rewindBuffer.size() > 2 ? 2 : rewindBuffer.size() - 1;
+	if (replay > 0 && rewindBuffer.get(replay, rewindState))
+	{
+		applyState(rewindState);
+		for (size_t i = 0; i < replay; i++)
 		{
-			return false;
+			runFrame();
 		}
+	}
+
+	rewindBuffer.get(0, rewindState);
+	return applyState(rewindState);
+}
 
-		cyclesThisUpdate += cycles;
-		this->timerStep(cycles);
-		this->gpuStep(cycles);
+bool sGBEmulator::runFrame()
+{
+	scheduler.schedule(Scheduler::FRAME_END, clock->now() + MAXCYCLES);
+	reschedule();
+
+	while (true)
+	{
+		deadline = scheduler.nextTime();
+		if (stepping && clock->now() + 1 < deadline)
+		{
+			deadline = clock->now() + 1;
+		}
+		while (clock->now() < deadline)
+		{
+			if (this->cpuStep((int) (deadline - clock->now())) == -1)
+			{
+				return false;
+			}
+		}
+
+		this->sync(clock->now());
 		this->interruptStep();
+
+		bool frameDone = false;
+		while (scheduler.nextTime() <= clock->now())
+		{
+			if (scheduler.pop() == Scheduler::FRAME_END)
+			{
+				frameDone = true;
+			}
+		}
+		if (frameDone)
+		{
+			return true;
+		}
+		reschedule();
+	}
+}
+
+void sGBEmulator::sync(uint64_t now)
+{
+	int elapsed = (int) (now - syncedCycles);
+	if (elapsed > 0)
+	{
+		this->timerStep(now);
+		this->gpuStep(elapsed);
+		syncedCycles = now;
+	}
+}
+
+/*
+ * The gpu counts from syncedCycles, which can be behind the clock by the
+ * cycles of an interrupt dispatched since the last sync.
+ */
+void sGBEmulator::reschedule()
+{
+	if (cpu->isHalted())
+	{
+		rescheduleHalted();
+		return;
+	}
+
+	scheduleTimer();
+
+	int gpuCycles = gpu->cyclesUntilEvent();
+	if (gpuCycles < 0) {
+		scheduler.cancel(Scheduler::GPU_MODE);
+	} else {
+		scheduler.schedule(Scheduler::GPU_MODE, syncedCycles + gpuCycles);
+	}
+}
+
+void sGBEmulator::scheduleTimer()
+{
+	uint64_t overflow = timer->nextOverflow();
+	if (overflow == Timer::NEVER) {
+		scheduler.cancel(Scheduler::TIMER);
+	} else {
+		scheduler.schedule(Scheduler::TIMER, overflow);
+	}
+}
+
+/*
+ * Nothing reads the gpu while the cpu is halted, so the only gpu events
+ * worth stopping for are the ones that can wake it. It steps over
+ * everything in between in one go.
+ */
+void sGBEmulator::rescheduleHalted()
+{
+	BYTE enabled = cpu->getMMU()->getInterrupts().readIE();
+
+	// overflows reload TIMA, so they're never skipped
+	scheduleTimer();
+
+	// any mode change or line can request a STAT interrupt
+	int gpuCycles = -1;
+	if (enabled & INT_STAT) {
+		gpuCycles = gpu->cyclesUntilEvent();
+	} else if (enabled & INT_VBLANK) {
+		gpuCycles = gpu->cyclesUntilVBlank();
 	}
+	if (gpuCycles < 0) {
+		scheduler.cancel(Scheduler::GPU_MODE);
+	} else {
+		scheduler.schedule(Scheduler::GPU_MODE, syncedCycles + gpuCycles);
+	}
+}
+
+/*
+ * A write to a timer register or LCDC is about to land mid instruction.
+ * Bring the timer & gpu up to the end of the last instruction so the old
+ * value covers those cycles, then stop after this instruction to
+ * reschedule.
+ */
+void sGBEmulator::timingWrite()
+{
+	uint64_t now = clock->now();
+	this->sync(now);
+
+	deadline = now;
+	cpu->stopRun();
+}
+
+void sGBEmulator::saveState(vector<BYTE>& out)
+{
+	writeState(out, true);
+}
+
+void sGBEmulator::writeState(vector<BYTE>& out, bool withFrame)
+{
+	out.clear();
+	StateWriter writer(out);
+	writer.writeHeader(rom ? rom->hash() : 0, rom ? rom->size() : 0);
+
+	cpu->saveState(writer);
+	cpu->getMMU()->saveState(writer);
+	timer->saveState(writer);
+	gpu->saveState(writer);
+	if (withFrame)
+	{
+		gpu->saveFrame(writer);
+	}
+
+	// the scheduler is rebuilt from these at the start of every update
+	writer.beginChunk("EMU ");
+	writer.write64(syncedCycles);
+	writer.endChunk();
+}
 
-	// renderScreen();
+bool sGBEmulator::loadState(const vector<BYTE>& in)
+{
+	StateReader reader(in.empty() ? NULL : &in[0], in.size());
+
+	uint64_t romHash;
+	uint32_t romSize;
+	if (!reader.readHeader(romHash, romSize))
+	{
+		cout << "Error: not a save state or from another version" << endl;
+		return false;
+	}
+	if (!rom || romHash != rom->hash() || romSize != rom->size())
+	{
+		cout << "Error: save state is for a different ROM" << endl;
+		return false;
+	}
+
+	const char* tags[] = {"CPU ", "MMU ", "TIMR", "GPU ", "EMU "};
+	for (int i = 0; i < 5; i++)
+	{
+		if (!reader.hasChunk(tags[i]))
+		{
+			cout << "Error: save state has no " << tags[i] << "chunk" << endl;
+			return false;
+		}
+	}
+
+	// a chunk can still turn out to be bad half way through loading, put
+	// back what was there if it does
+	saveState(previousState);
+	if (!applyState(in))
+	{
+		applyState(previousState);
+		return false;
+	}
 	return true;
 }
 
-int sGBEmulator::cpuStep() 
+bool sGBEmulator::applyState(const vector<BYTE>& in)
 {
-	return cpu->step();
+	StateReader reader(&in[0], in.size());
+
+	if (!cpu->loadState(reader) || !cpu->getMMU()->loadState(reader) ||
+		!timer->loadState(reader) || !gpu->loadState(reader))
+	{
+		cout << "Error: save state is damaged" << endl;
+		return false;
+	}
+
+	// states without a picture keep the one on screen
+	if (reader.hasChunk("FRAM") && !gpu->loadFrame(reader))
+	{
+		cout << "Error: save state is damaged" << endl;
+		return false;
+	}
+
+	reader.openChunk("EMU ");
+	syncedCycles = reader.read64();
+	deadline = clock->now();
+	return reader.ok();
+}
+
+bool sGBEmulator::saveState(const string& path)
+{
+	vector<BYTE> state;
+	saveState(state);
+
+	ofstream stateFile(path.c_str(), ofstream::binary);
+	stateFile.write((const char*) &state[0], state.size());
+	if (!stateFile)
+	{
+		cout << "Error writing save state to: " << path << endl;
+		return false;
+	}
+	return true;
+}
+
+bool sGBEmulator::loadState(const string& path)
+{
+	ifstream stateFile(path.c_str(), ifstream::binary);
+	if (!stateFile.is_open())
+	{
+		cout << "Error opening save state: " << path << endl;
+		return false;
+	}
+
+	vector<BYTE> state((istreambuf_iterator<char>(stateFile)), istreambuf_iterator<char>());
+	return loadState(state);
+}
+
+#ifdef SGB_PROFILE
+bool sGBEmulator::writeProfile(const string& path)
+{
+	ofstream report((path + ".txt").c_str());
+	ofstream stacks((path + ".folded").c_str());
+	if (!report.is_open() || !stacks.is_open())
+	{
+		cout << "Error writing profile to: " << path << endl;
+		return false;
+	}
+
+	cpu->writeProfile(report, stacks);
+	return true;
 }
+#endif
 
-void sGBEmulator::timerStep(int cycles)
+int sGBEmulator::cpuStep(int budget) 
 {
-	timer->step(cycles);
+	PerfTimer timing(perfTicksSpent.cpu);
+	return cpu->run(budget);
+}
+
+void sGBEmulator::timerStep(uint64_t now)
+{
+	PerfTimer timing(perfTicksSpent.timer);
+	timer->update(now);
 }
 
 void sGBEmulator::gpuStep(int cycles) 
 {
+	PerfTimer timing(perfTicksSpent.gpu);
 	gpu->step(cycles);
 }
 
+// the timer & gpu may have just requested one
 void sGBEmulator::interruptStep() 
 {
-
+	PerfTimer timing(perfTicksSpent.interrupt);
+	cpu->interrupt();
 }
\ No newline at end of file
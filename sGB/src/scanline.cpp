@@ -0,0 +1,229 @@
+#include "scanline.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define SGB_SSE2
+#include <emmintrin.h>
+#endif
+
+// AVX2 is built per function & only used when the cpu reports it
+#if defined(SGB_SSE2) && defined(__GNUC__)
+#define SGB_AVX2
+#include <immintrin.h>
+#endif
+
+// bit 7 of a row's low & high byte make up pixel 0's colour
+void decodeTileScalar(const BYTE* data, BYTE* out)
+{
+	for (int row = 0; row < 8; row++)
+	{
+		BYTE low = data[row * 2];
+		BYTE high = data[row * 2 + 1];
+		for (int i = 0; i < 8; i++)
+		{
+			int bit = 7 - i;
+			out[row * 8 + i] = (((high >> bit) & 1) << 1) | ((low >> bit) & 1);
+		}
+	}
+}
+
+/*
+ * A sprite pixel shows unless it's behind the background & that isn't
+ * colour 0.
+ */
+void composeScanlineScalar(const BYTE* background, const BYTE* sprites, const PIXEL* colours, PIXEL* out, int width)
+{
+	for (int x = 0; x < width; x++)
+	{
+		BYTE sprite = sprites[x];
+		BYTE colour = background[x];
+
+		if (sprite && (!(sprite & 0x08) || colour == 0)) {
+			out[x] = colours[4 + (sprite & 0x07)];
+		} else {
+			out[x] = colours[colour];
+		}
+	}
+}
+
+#ifdef SGB_SSE2
+
+/*
+ * Each row's low & high byte are spread over 8 lanes apiece, then tested
+ * against one bit per lane.
+ */
+static void decodeTileSSE2(const BYTE* data, BYTE* out)
+{
+	const __m128i bits = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, (char) 128,
+		1, 2, 4, 8, 16, 32, 64, (char) 128);
+	const __m128i weights = _mm_set_epi8(2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1, 1, 1);
+
+	__m128i rows = _mm_loadu_si128((const __m128i*) data);
+	__m128i bytes[2] = { _mm_unpacklo_epi8(rows, rows), _mm_unpackhi_epi8(rows, rows) };
+
+	for (int half = 0; half < 2; half++)
+	{
+		// low0 x2, high0 x2, low1 x2 ... -> low0 x4, high0 x4, low1 x4 ...
+		__m128i words[2] = { _mm_unpacklo_epi16(bytes[half], bytes[half]),
+			_mm_unpackhi_epi16(bytes[half], bytes[half]) };
+
+		for (int pair = 0; pair < 2; pair++)
+		{
+			__m128i row[2] = { _mm_unpacklo_epi32(words[pair], words[pair]),
+				_mm_unpackhi_epi32(words[pair], words[pair]) };
+
+			for (int r = 0; r < 2; r++)
+			{
+				// low x8 | high x8 -> 0/1 | 0/2 per pixel
+				__m128i set = _mm_cmpeq_epi8(_mm_and_si128(row[r], bits), bits);
+				__m128i planes = _mm_and_si128(set, weights);
+				__m128i pixels = _mm_or_si128(planes, _mm_srli_si128(planes, 8));
+				_mm_storel_epi64((__m128i*) (out + (half * 4 + pair * 2 + r) * 8), pixels);
+			}
+		}
+	}
+}
+
+/*
+ * Picks the colour slot (0-3 background, 4-11 sprite) for 16 pixels. SSE2
+ * has no byte shuffle for the palette lookup, so that stays scalar.
+ */
+static void composeScanlineSSE2(const BYTE* background, const BYTE* sprites, const PIXEL* colours, PIXEL* out, int width)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i behind = _mm_set1_epi8(0x08);
+	const __m128i index = _mm_set1_epi8(0x07);
+	const __m128i base = _mm_set1_epi8(4);
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16)
+	{
+		__m128i sprite = _mm_loadu_si128((const __m128i*) (sprites + x));
+		__m128i colour = _mm_loadu_si128((const __m128i*) (background + x));
+
+		__m128i front = _mm_or_si128(_mm_cmpeq_epi8(_mm_and_si128(sprite, behind), zero),
+			_mm_cmpeq_epi8(colour, zero));
+		__m128i visible = _mm_andnot_si128(_mm_cmpeq_epi8(sprite, zero), front);
+		__m128i spriteSlot = _mm_add_epi8(_mm_and_si128(sprite, index), base);
+		__m128i slot = _mm_or_si128(_mm_and_si128(visible, spriteSlot), _mm_andnot_si128(visible, colour));
+
+		alignas(16) BYTE slots[16];
+		_mm_store_si128((__m128i*) slots, slot);
+		for (int i = 0; i < 16; i++)
+		{
+			out[x + i] = colours[slots[i]];
+		}
+	}
+	composeScanlineScalar(background + x, sprites + x, colours, out + x, width - x);
+}
+
+#endif
+
+#ifdef SGB_AVX2
+
+/*
+ * Same slot selection as SSE2 over 32 pixels, then each byte of the ARGB
+ * colour is looked up with a byte shuffle & the four planes interleaved.
+ */
+__attribute__((target("avx2")))
+static void composeScanlineAVX2(const BYTE* background, const BYTE* sprites, const PIXEL* colours, PIXEL* out, int width)
+{
+	// one table per byte of the pixel, repeated in both 128 bit lanes
+	alignas(32) BYTE planes[4][32] = {};
+	for (int slot = 0; slot < 12; slot++)
+	{
+		for (int b = 0; b < 4; b++)
+		{
+			planes[b][slot] = planes[b][slot + 16] = (colours[slot] >> (b * 8)) & 0xff;
+		}
+	}
+	const __m256i blue = _mm256_load_si256((const __m256i*) planes[0]);
+	const __m256i green = _mm256_load_si256((const __m256i*) planes[1]);
+	const __m256i red = _mm256_load_si256((const __m256i*) planes[2]);
+	const __m256i alpha = _mm256_load_si256((const __m256i*) planes[3]);
+
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i behind = _mm256_set1_epi8(0x08);
+	const __m256i index = _mm256_set1_epi8(0x07);
+	const __m256i base = _mm256_set1_epi8(4);
+
+	int x = 0;
+	for (; x + 32 <= width; x += 32)
+	{
+		__m256i sprite = _mm256_loadu_si256((const __m256i*) (sprites + x));
+		__m256i colour = _mm256_loadu_si256((const __m256i*) (background + x));
+
+		__m256i front = _mm256_or_si256(_mm256_cmpeq_epi8(_mm256_and_si256(sprite, behind), zero),
+			_mm256_cmpeq_epi8(colour, zero));
+		__m256i visible = _mm256_andnot_si256(_mm256_cmpeq_epi8(sprite, zero), front);
+		__m256i spriteSlot = _mm256_add_epi8(_mm256_and_si256(sprite, index), base);
+		__m256i slot = _mm256_blendv_epi8(colour, spriteSlot, visible);
+
+		__m256i b = _mm256_shuffle_epi8(blue, slot);
+		__m256i g = _mm256_shuffle_epi8(green, slot);
+		__m256i r = _mm256_shuffle_epi8(red, slot);
+		__m256i a = _mm256_shuffle_epi8(alpha, slot);
+
+		// unpacks work within each lane: p0 holds pixels 0-3 & 16-19 etc.
+		__m256i bgLow = _mm256_unpacklo_epi8(b, g);
+		__m256i bgHigh = _mm256_unpackhi_epi8(b, g);
+		__m256i raLow = _mm256_unpacklo_epi8(r, a);
+		__m256i raHigh = _mm256_unpackhi_epi8(r, a);
+		__m256i p0 = _mm256_unpacklo_epi16(bgLow, raLow);
+		__m256i p1 = _mm256_unpackhi_epi16(bgLow, raLow);
+		__m256i p2 = _mm256_unpacklo_epi16(bgHigh, raHigh);
+		__m256i p3 = _mm256_unpackhi_epi16(bgHigh, raHigh);
+
+		__m256i* dest = (__m256i*) (out + x);
+		_mm256_storeu_si256(dest, _mm256_permute2x128_si256(p0, p1, 0x20));
+		_mm256_storeu_si256(dest + 1, _mm256_permute2x128_si256(p2, p3, 0x20));
+		_mm256_storeu_si256(dest + 2, _mm256_permute2x128_si256(p0, p1, 0x31));
+		_mm256_storeu_si256(dest + 3, _mm256_permute2x128_si256(p2, p3, 0x31));
+	}
+	composeScanlineScalar(background + x, sprites + x, colours, out + x, width - x);
+}
+
+static bool hasAVX2()
+{
+	static const bool supported = __builtin_cpu_supports("avx2");
+	return supported;
+}
+
+#endif
+
+void decodeTile(const BYTE* data, BYTE* out)
+{
+#ifdef SGB_SSE2
+	decodeTileSSE2(data, out);
+#else
+	decodeTileScalar(data, out);
+#endif
+}
+
+void composeScanline(const BYTE* background, const BYTE* sprites, const PIXEL* colours, PIXEL* out, int width)
+{
+#ifdef SGB_AVX2
+	if (hasAVX2()) {
+		composeScanlineAVX2(background, sprites, colours, out, width);
+		return;
+	}
+#endif
+#ifdef SGB_SSE2
+	composeScanlineSSE2(background, sprites, colours, out, width);
+#else
+	composeScanlineScalar(background, sprites, colours, out, width);
+#endif
+}
+
+const char* scanlineKernel()
+{
+#ifdef SGB_AVX2
+	if (hasAVX2()) {
+		return "avx2";
+	}
+#endif
+#ifdef SGB_SSE2
+	return "sse2";
+#else
+	return "scalar";
+#endif
+}
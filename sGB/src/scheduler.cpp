@@ -0,0 +1,108 @@
+#include "scheduler.hpp"
+
+Scheduler::Scheduler() :
+count(0)
+{
+	clear();
+}
+
+void Scheduler::clear()
+{
+	count = 0;
+	for (int i = 0; i < EVENT_COUNT; i++)
+	{
+		position[i] = -1;
+	}
+}
+
+void Scheduler::schedule(enum event type, uint64_t when)
+{
+	int i = position[type];
+	if (i < 0)
+	{
+		i = count++;
+		heap[i].type = type;
+		position[type] = i;
+	} else if (when > heap[i].when)
+	{
+		heap[i].when = when;
+		siftDown(i);
+		return;
+	}
+
+	heap[i].when = when;
+	siftUp(i);
+}
+
+void Scheduler::cancel(enum event type)
+{
+	int i = position[type];
+	if (i < 0)
+	{
+		return;
+	}
+
+	// move the last entry into the hole, it may belong either side of it
+	count--;
+	position[type] = -1;
+	if (i != count)
+	{
+		enum event moved = heap[count].type;
+		heap[i] = heap[count];
+		position[moved] = i;
+		siftUp(i);
+		siftDown(position[moved]);
+	}
+}
+
+enum Scheduler::event Scheduler::pop()
+{
+	enum event type = heap[0].type;
+	cancel(type);
+	return type;
+}
+
+void Scheduler::swap(int a, int b)
+{
+	entry temp = heap[a];
+	heap[a] = heap[b];
+	heap[b] = temp;
+	position[heap[a].type] = a;
+	position[heap[b].type] = b;
+}
+
+void Scheduler::siftUp(int i)
+{
+	while (i > 0)
+	{
+		int parent = (i - 1) / 2;
+		if (heap[parent].when <= heap[i].when)
+		{
+			return;
+		}
+		swap(i, parent);
+		i = parent;
+	}
+}
+
+void Scheduler::siftDown(int i)
+{
+	while (true)
+	{
+		int smallest = i;
+		int left = i * 2 + 1;
+		int right = left + 1;
+
+		if (left < count && heap[left].when < heap[smallest].when) {
+			smallest = left;
+		}
+		if (right < count && heap[right].when < heap[smallest].when) {
+			smallest = right;
+		}
+		if (smallest == i) {
+			return;
+		}
+		swap(i, smallest);
+		i = smallest;
+	}
+}
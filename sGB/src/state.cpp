@@ -0,0 +1,178 @@
+#include "state.hpp"
+#include <cstring>
+
+using namespace std;
+
+static const char STATE_MAGIC[4] = {'S', 'G', 'B', 'S'};
+// magic, version, ROM hash & size
+static const size_t HEADER_LENGTH = 4 + 4 + 8 + 4;
+// tag & length in front of each chunk
+static const size_t CHUNK_HEADER_LENGTH = 4 + 4;
+
+void StateWriter::writeHeader(uint64_t romHash, uint32_t romSize)
+{
+	writeBytes(STATE_MAGIC, 4);
+	write32(STATE_VERSION);
+	write64(romHash);
+	write32(romSize);
+}
+
+void StateWriter::beginChunk(const char* tag)
+{
+	writeBytes(tag, 4);
+	// length is filled in by endChunk
+	write32(0);
+	chunkStart = out.size();
+}
+
+void StateWriter::endChunk()
+{
+	uint32_t length = out.size() - chunkStart;
+	for (int i = 0; i < 4; i++)
+	{
+		out[chunkStart - 4 + i] = (length >> (i * 8)) & 0xff;
+	}
+}
+
+void StateWriter::write16(WORD value)
+{
+	write8(value & 0xff);
+	write8(value >> 8);
+}
+
+void StateWriter::write32(uint32_t value)
+{
+	write16(value & 0xffff);
+	write16(value >> 16);
+}
+
+void StateWriter::write64(uint64_t value)
+{
+	write32(value & 0xffffffff);
+	write32(value >> 32);
+}
+
+void StateWriter::writeBytes(const void* data, size_t length)
+{
+	const BYTE* bytes = (const BYTE*) data;
+	out.insert(out.end(), bytes, bytes + length);
+}
+
+StateReader::StateReader(const BYTE* data, size_t length) :
+data(data),
+length(length),
+chunks(HEADER_LENGTH),
+position(0),
+end(length),
+good(true)
+{
+
+}
+
+bool StateReader::readHeader(uint64_t& romHash, uint32_t& romSize)
+{
+	position = 0;
+	end = length;
+
+	BYTE magic[4];
+	readBytes(magic, 4);
+	uint32_t version = read32();
+	romHash = read64();
+	romSize = read32();
+
+	return good && memcmp(magic, STATE_MAGIC, 4) == 0 && version == STATE_VERSION;
+}
+
+bool StateReader::findChunk(const char* tag, size_t& start, size_t& chunkLength)
+{
+	size_t at = chunks;
+	while (at + CHUNK_HEADER_LENGTH <= length)
+	{
+		const BYTE* header = data + at;
+		chunkLength = header[4] | (header[5] << 8) | (header[6] << 16) | ((uint32_t) header[7] << 24);
+		start = at + CHUNK_HEADER_LENGTH;
+		if (chunkLength > length - start)
+		{
+			return false;
+		}
+		if (memcmp(header, tag, 4) == 0)
+		{
+			return true;
+		}
+		at = start + chunkLength;
+	}
+	return false;
+}
+
+bool StateReader::hasChunk(const char* tag)
+{
+	size_t start, chunkLength;
+	return findChunk(tag, start, chunkLength);
+}
+
+bool StateReader::openChunk(const char* tag)
+{
+	size_t start, chunkLength;
+	if (!findChunk(tag, start, chunkLength))
+	{
+		position = end = 0;
+		good = false;
+		return false;
+	}
+
+	position = start;
+	end = start + chunkLength;
+	return true;
+}
+
+BYTE StateReader::read8()
+{
+	if (position >= end)
+	{
+		good = false;
+		return 0;
+	}
+	return data[position++];
+}
+
+WORD StateReader::read16()
+{
+	WORD low = read8();
+	return low | (read8() << 8);
+}
+
+uint32_t StateReader::read32()
+{
+	uint32_t low = read16();
+	return low | ((uint32_t) read16() << 16);
+}
+
+uint64_t StateReader::read64()
+{
+	uint64_t low = read32();
+	return low | ((uint64_t) read32() << 32);
+}
+
+void StateReader::readBytes(void* out, size_t count)
+{
+	if (count > remaining())
+	{
+		memset(out, 0, count);
+		position = end;
+		good = false;
+		return;
+	}
+	memcpy(out, data + position, count);
+	position += count;
+}
+
+uint64_t hashBytes(const BYTE* data, size_t length)
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= data[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
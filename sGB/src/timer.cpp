@@ -1,65 +1,120 @@
 #include "timer.hpp"
-#include "CPU.hpp"
 
-Timer::Timer()
+// log2 of the cycles per TIMA count for each TAC frequency
+static const int periodShifts[4] = { 10, 4, 6, 8 };
+
+Timer::Timer(MMU* mmu) :
+interrupts(&mmu->getInterrupts())
 {
 	reset();
 }
 
-void Timer::step(int cycles)
+void Timer::reset()
 {
-	mmu->dividerRegister(cycles); 
+	divBase = 0;
+	tima = 0;
+	timaBase = 0;
+	tma = 0;
+	tac = 0;
+}
 
-	// the clock must be enabled to update the clock 
-	if (isTimerEnabled())
-	{ 
-	 	timerCounter -= cycles; 
+int Timer::periodShift() const
+{
+	return periodShifts[tac & 0x03];
+}
 
-	  	// enough cpu clock cycles have happened to update the timer
-	  	if (timerCounter <= 0)
-		{
-		    // reset m_TimerTracer to the correct value
-		    SetClockFreq( );
+BYTE Timer::currentTIMA(uint64_t now) const
+{
+	if (!isEnabled())
+	{
+		return tima;
+	}
+	// overflows are handled as they're due, so this stays under 256
+	return tima + (counts(now) - timaBase);
+}
 
-	    // timer about to overflow
-	    if (mmu->readByte(TIMA) == 255)
-	    { 
-	    	mmu->writeByte(TIMA, mmu->readByte(TMA));
-	    	//RequestInterupt(2);
-	    }
-	    else
-	    {
-	    	mmu->writeByte(TIMA, mmu->readByte(TIMA)+1) ;
-	    }
-	  } 
+BYTE Timer::read(WORD address, uint64_t now)
+{
+	switch(address)
+	{
+		case DIV: return (now - divBase) >> 8;
+		case TIMA: return currentTIMA(now);
+		case TMA: return tma;
+		// unused TAC bits read as 1
+		default: return tac | 0xf8;
 	}
 }
 
-void Timer::reset()
+/*
+ * Writes change when TIMA next counts, so the emulator reschedules the
+ * overflow after each one
+ */
+void Timer::write(WORD address, BYTE value, uint64_t now)
+{
+	switch(address)
+	{
+		case DIV:
+			// any write resets the divider, which restarts TIMA's count
+			tima = currentTIMA(now);
+			divBase = now;
+			timaBase = 0;
+			break;
+		case TIMA:
+			tima = value;
+			timaBase = counts(now);
+			break;
+		case TMA:
+			tma = value;
+			break;
+		default:
+			tima = currentTIMA(now);
+			tac = value & 0x07;
+			timaBase = counts(now);
+			break;
+	}
+}
+
+uint64_t Timer::nextOverflow() const
 {
-	timerCounter = 1024;
-	dividerCounter = 0;
+	if (!isEnabled())
+	{
+		return NEVER;
+	}
+	return divBase + ((timaBase + 256 - tima) << periodShift());
 }
 
-bool Timer::isTimerEnabled()
+void Timer::update(uint64_t now)
 {
-	// bit 2 specifies if timer is enabled
-	BYTE val = mmu->readByte(TMC);
-	return ((val >> 2) & 1) ? true : false;
+	for (uint64_t overflow = nextOverflow(); overflow <= now; overflow = nextOverflow())
+	{
+		timaBase += 256 - tima;
+		tima = tma;
+		interrupts->request(INT_TIMER);
+	}
+}
+
+void Timer::saveState(StateWriter& writer)
+{
+	writer.beginChunk("TIMR");
+	writer.write64(divBase);
+	writer.write8(tima);
+	writer.write64(timaBase);
+	writer.write8(tma);
+	writer.write8(tac);
+	writer.endChunk();
 }
 
-void Timer::setTimerFreq()
+bool Timer::loadState(StateReader& reader)
 {
-	BYTE freq = mmu->getTimerFreq();
-	switch(freq)
+	if (!reader.openChunk("TIMR"))
 	{
-		case 0: timerCounter = 1024;
-				break;
-		case 1: timerCounter = 16;
-				break;
-		case 2: timerCounter = 64;
-				break;
-		case 3: timerCounter = 256;
-				break;
+		return false;
 	}
-}
\ No newline at end of file
+
+	divBase = reader.read64();
+	tima = reader.read8();
+	timaBase = reader.read64();
+	tma = reader.read8();
+	tac = reader.read8() & 0x07;
+	return reader.ok();
+}
@@ -0,0 +1,62 @@
+# Runs one of the generated ROMs through sGB_headless & checks the states it
+# saves. Called by ctest with -P & these set:
+#   HEADLESS, ROMS   the sGB_headless & sGB_test_roms binaries
+#   DIR              where ROMs & states go, one per test
+#   ROM              the ROM's name, without .gb
+#   CHECK            roundtrip: 200 frames straight match 100, a save, a load
+#                    & 100 more, byte for byte
+#                    scheduler: 300 frames match the same with --step, which
+#                    syncs everything after every instruction
+#                    registers: B & C are EXPECT_B & EXPECT_C after 200
+#                    frames
+#                    jit: 300 frames with every compiled block checked
+#                    against the interpreter
+
+file(MAKE_DIRECTORY ${DIR})
+execute_process(COMMAND ${ROMS} ${DIR} RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+	message(FATAL_ERROR "Couldn't write the test ROMs")
+endif()
+
+set(PATH ${DIR}/${ROM}.gb)
+set(PREFIX ${DIR}/${ROM}_${CHECK})
+
+function(run)
+	execute_process(COMMAND ${HEADLESS} ${PATH} ${ARGN} RESULT_VARIABLE result OUTPUT_QUIET)
+	if (NOT result EQUAL 0)
+		message(FATAL_ERROR "sGB_headless ${ROM}.gb ${ARGN} failed")
+	endif()
+endfunction()
+
+function(compare first second)
+	execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${first} ${second} RESULT_VARIABLE result)
+	if (NOT result EQUAL 0)
+		message(FATAL_ERROR "${first} & ${second} differ")
+	endif()
+endfunction()
+
+if (CHECK STREQUAL "roundtrip")
+	run(--frames 200 --save-state ${PREFIX}_straight.st)
+	run(--frames 100 --save-state ${PREFIX}_half.st)
+	run(--load-state ${PREFIX}_half.st --frames 100 --save-state ${PREFIX}_resumed.st)
+	compare(${PREFIX}_straight.st ${PREFIX}_resumed.st)
+elseif (CHECK STREQUAL "scheduler")
+	run(--frames 300 --save-state ${PREFIX}_scheduled.st)
+	run(--frames 300 --step --save-state ${PREFIX}_stepped.st)
+	compare(${PREFIX}_scheduled.st ${PREFIX}_stepped.st)
+elseif (CHECK STREQUAL "registers")
+	run(--frames 200 --save-state ${PREFIX}.st)
+	# the 20 byte header, then the CPU chunk's tag & length, A, F, C & B
+	file(READ ${PREFIX}.st registers OFFSET 30 LIMIT 2 HEX)
+	string(SUBSTRING ${registers} 0 2 c)
+	string(SUBSTRING ${registers} 2 2 b)
+	math(EXPR b "0x${b}")
+	math(EXPR c "0x${c}")
+	if (NOT b EQUAL EXPECT_B OR NOT c EQUAL EXPECT_C)
+		message(FATAL_ERROR "B & C are ${b} & ${c}, expected ${EXPECT_B} & ${EXPECT_C}")
+	endif()
+elseif (CHECK STREQUAL "jit")
+	run(--frames 300 --jit-verify)
+else()
+	message(FATAL_ERROR "Unknown check ${CHECK}")
+endif()
@@ -0,0 +1,270 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "constants.hpp"
+#include "rom.hpp"
+
+using namespace std;
+
+/*
+ * Writes the ROMs the regression tests run, see check.cmake.
+ *
+ * usage: sGB_test_roms <directory>
+ */
+
+// interrupt handlers bump a counter, vblank in B & timer in C
+const vector<BYTE> COUNT_VBLANK = {
+	0x04,			// INC B
+	0xD9			// RETI
+};
+const vector<BYTE> COUNT_TIMER = {
+	0x0C,			// INC C
+	0xD9			// RETI
+};
+
+/*
+ * LCD on, TIMA reloading from 0xC0 at 4096Hz so it overflows every 65536
+ * cycles, vblank & timer interrupts enabled & IF cleared. Ends at 016D
+ * with interrupts on.
+ */
+const vector<BYTE> IRQ_SETUP = {
+	0xF3,			// DI
+	0x31, 0xFE, 0xFF,	// LD SP, 0xFFFE
+	0xAF,			// XOR A
+	0x47,			// LD B, A
+	0x4F,			// LD C, A
+	0x3E, 0xC0,		// LD A, 0xC0
+	0xE0, 0x05,		// LDH (TIMA), A
+	0xE0, 0x06,		// LDH (TMA), A
+	0x3E, 0x04,		// LD A, 0x04
+	0xE0, 0x07,		// LDH (TAC), A
+	0x3E, 0x91,		// LD A, 0x91
+	0xE0, 0x40,		// LDH (LCDC), A
+	0x3E, 0x05,		// LD A, 0x05
+	0xE0, 0xFF,		// LDH (IE), A
+	0xAF,			// XOR A
+	0xE0, 0x0F,		// LDH (IF), A
+	0xFB			// EI
+};
+
+// sleeps between interrupts
+const vector<BYTE> IRQ_HALT = {
+	0x76,			// loop: HALT
+	0x18, 0xFD		// JR loop
+};
+
+// spins through ROM blocks between interrupts
+const vector<BYTE> IRQ_BUSY = {
+	0x14,			// loop: INC D
+	0x7A,			// LD A, D
+	0xAB,			// XOR E
+	0x5F,			// LD E, A
+	0x18, 0xFA		// JR loop
+};
+
+/*
+ * Switches through ROM banks 1-3 calling a copy loop in each, folds DIV,
+ * LY & TIMA into B, C & D, writes VRAM, rewrites TAC & stores through
+ * LD (C), A, with vblank, LYC & timer interrupts counting in HRAM.
+ */
+const vector<BYTE> MIX_MAIN = {
+	0xF3,			// DI
+	0x31, 0xFE, 0xFF,	// LD SP, 0xFFFE
+	0x3E, 0x05,		// LD A, 0x05
+	0xE0, 0x07,		// LDH (TAC), A
+	0x3E, 0x40,		// LD A, 0x40
+	0xE0, 0x41,		// LDH (STAT), A
+	0x3E, 0x50,		// LD A, 0x50
+	0xE0, 0x45,		// LDH (LYC), A
+	0x3E, 0x07,		// LD A, 0x07
+	0xE0, 0xFF,		// LDH (IE), A
+	0x3E, 0x91,		// LD A, 0x91
+	0xE0, 0x40,		// LDH (LCDC), A
+	0xAF,			// XOR A
+	0xE0, 0x0F,		// LDH (IF), A
+	0xFB,			// EI
+	0x1E, 0x01,		// LD E, 0x01
+	0x7B,			// loop: LD A, E
+	0xEA, 0x00, 0x20,	// LD (0x2000), A
+	0xCD, 0x00, 0x40,	// CALL 0x4000
+	0x1C,			// INC E
+	0x7B,			// LD A, E
+	0xE6, 0x03,		// AND 0x03
+	0x20, 0x01,		// JR NZ, bank
+	0x3C,			// INC A
+	0x5F,			// bank: LD E, A
+	0xF0, 0x04,		// LDH A, (DIV)
+	0x80,			// ADD A, B
+	0x47,			// LD B, A
+	0xF0, 0x44,		// LDH A, (LY)
+	0xA9,			// XOR C
+	0x4F,			// LD C, A
+	0xF0, 0x05,		// LDH A, (TIMA)
+	0x82,			// ADD A, D
+	0x57,			// LD D, A
+	0x26, 0x80,		// LD H, 0x80
+	0x68,			// LD L, B
+	0x71,			// LD (HL), C
+	0x78,			// LD A, B
+	0xE6, 0x03,		// AND 0x03
+	0xF6, 0x04,		// OR 0x04
+	0xE0, 0x07,		// LDH (TAC), A
+	0xC5,			// PUSH BC
+	0x0E, 0x84,		// LD C, 0x84
+	0x7A,			// LD A, D
+	0xE2,			// LD (C), A
+	0xC1,			// POP BC
+	0x18, 0xD2		// JR loop
+};
+
+/*
+ * Calls every RST vector in turn, each sets its own bit in B, then loads C
+ * once they've all returned
+ */
+const vector<BYTE> RST_MAIN = {
+	0xF3,			// DI
+	0x31, 0xFE, 0xFF,	// LD SP, 0xFFFE
+	0x06, 0x00,		// LD B, 0x00
+	0xC7,			// RST 00H
+	0xCF,			// RST 08H
+	0xD7,			// RST 10H
+	0xDF,			// RST 18H
+	0xE7,			// RST 20H
+	0xEF,			// RST 28H
+	0xF7,			// RST 30H
+	0xFF,			// RST 38H
+	0x0E, 0x5A,		// LD C, 0x5A
+	0x18, 0xFE		// loop: JR loop
+};
+
+// handler for the RST vector at 8 * bit
+vector<BYTE> setBit(int bit)
+{
+	return {
+		0x3E, (BYTE) (1 << bit),	// LD A, 1 << bit
+		0xB0,			// OR B
+		0x47,			// LD B, A
+		0xC9			// RET
+	};
+}
+
+// handler that counts in HRAM at address, 8 bytes so it fills its slot
+vector<BYTE> countIn(BYTE address)
+{
+	return {
+		0xF5,			// PUSH AF
+		0xF0, address,		// LDH A, (address)
+		0x3C,			// INC A
+		0xE0, address,		// LDH (address), A
+		0xF1,			// POP AF
+		0xD9			// RETI
+	};
+}
+
+// at 4000 in every switchable bank: sums & copies 4100-410F to C000
+const vector<BYTE> MIX_BANK = {
+	0xC5,			// PUSH BC
+	0xD5,			// PUSH DE
+	0xE5,			// PUSH HL
+	0x21, 0x00, 0x41,	// LD HL, 0x4100
+	0x11, 0x00, 0xC0,	// LD DE, 0xC000
+	0x06, 0x10,		// LD B, 0x10
+	0xAF,			// XOR A
+	0x86,			// copy: ADD A, (HL)
+	0x4F,			// LD C, A
+	0x2A,			// LDI A, (HL)
+	0x12,			// LD (DE), A
+	0x13,			// INC DE
+	0x79,			// LD A, C
+	0x05,			// DEC B
+	0x20, 0xF7,		// JR NZ, copy
+	0xEA, 0x10, 0xC0,	// LD (0xC010), A
+	0xE1,			// POP HL
+	0xD1,			// POP DE
+	0xC1,			// POP BC
+	0xC9			// RET
+};
+
+void place(vector<BYTE>& rom, int address, const vector<BYTE>& code)
+{
+	copy(code.begin(), code.end(), rom.begin() + address);
+}
+
+// size bytes of the given cartridge type, jumping from the entry point to 0150
+vector<BYTE> image(size_t size, BYTE type, BYTE sizeCode)
+{
+	vector<BYTE> rom(size, 0);
+	place(rom, 0x0100, {0x00, 0xC3, 0x50, 0x01});
+	rom[ROM_TYPE_ADDRESS] = type;
+	rom[ROM_SIZE_ADDRESS] = sizeCode;
+	return rom;
+}
+
+vector<BYTE> irqROM(const vector<BYTE>& loop)
+{
+	vector<BYTE> rom = image(0x8000, ROM_ONLY, 0x00);
+	place(rom, 0x0040, COUNT_VBLANK);
+	place(rom, 0x0050, COUNT_TIMER);
+	place(rom, 0x0150, IRQ_SETUP);
+	place(rom, 0x0150 + IRQ_SETUP.size(), loop);
+	return rom;
+}
+
+// 64kB MBC1, so banks 1-3 take turns at 4000
+vector<BYTE> mixROM()
+{
+	vector<BYTE> rom = image(0x10000, ROM_MBC1, 0x01);
+	place(rom, 0x0040, countIn(0x80));
+	place(rom, 0x0048, countIn(0x81));
+	place(rom, 0x0050, countIn(0x82));
+	place(rom, 0x0150, MIX_MAIN);
+	for (int bank = 1; bank < 4; bank++)
+	{
+		place(rom, bank * 0x4000, MIX_BANK);
+		for (int i = 0; i < 0x100; i++)
+		{
+			rom[bank * 0x4000 + 0x100 + i] = bank * 37 + i * 13;
+		}
+	}
+	return rom;
+}
+
+vector<BYTE> rstROM()
+{
+	vector<BYTE> rom = image(0x8000, ROM_ONLY, 0x00);
+	for (int bit = 0; bit < 8; bit++)
+	{
+		place(rom, bit * 8, setBit(bit));
+	}
+	place(rom, 0x0150, RST_MAIN);
+	return rom;
+}
+
+bool write(const string& path, const vector<BYTE>& rom)
+{
+	ofstream out(path, ofstream::binary);
+	out.write((const char*) &rom[0], rom.size());
+	if (!out.good())
+	{
+		cout << "Error writing " << path << endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		cout << "Usage: " << argv[0] << " <directory>" << endl;
+		return 1;
+	}
+
+	string directory = string(argv[1]) + "/";
+	bool ok = write(directory + "irq_halt.gb", irqROM(IRQ_HALT));
+	ok = write(directory + "irq_busy.gb", irqROM(IRQ_BUSY)) && ok;
+	ok = write(directory + "mix.gb", mixROM()) && ok;
+	ok = write(directory + "rst.gb", rstROM()) && ok;
+	return ok ? 0 : 1;
+}